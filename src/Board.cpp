@@ -378,6 +378,7 @@ void Board::promotePawn(Board &board, Position pos, char newSymbol, int color) {
  */
 void Board::computeZobristHash() {
    zobristKey = 0;
+   materialKey = 0;
     for (int r = 0; r < 8; r++)
     {
         for (int c = 0; c < 8; c++) {
@@ -386,9 +387,34 @@ void Board::computeZobristHash() {
 				int idx = getPieceIndex(p->getSymbol(), p->getColor());
 				int square = r * 8 + c;
 				zobristKey ^= pieceKeys[idx][square];
+				materialKey += 1ULL << (4 * idx);
             }
         }
     }
+    if (sideToMove == 1)
+        zobristKey ^= sideKey;
+}
+/**
+ * @brief Board operation: count pieces of one kind from the material signature.
+ *
+ * @param pieceIndex getPieceIndex() of the piece.
+ * @return Number of such pieces on the board.
+ */
+int Board::materialCount(int pieceIndex) const {
+    return (int)((materialKey >> (4 * pieceIndex)) & 15);
+}
+/**
+ * @brief Board operation: check for a dead draw by material.
+ *
+ * @details No pawns, rooks or queens and at most one knight or bishop in total.
+ * @return true if neither side can ever mate.
+ */
+bool Board::insufficientMaterial() const {
+    // White P=0 N=1 B=2 R=3 Q=4, black +6
+    int heavy = materialCount(0) + materialCount(3) + materialCount(4)
+        + materialCount(6) + materialCount(9) + materialCount(10);
+    int minors = materialCount(1) + materialCount(2) + materialCount(7) + materialCount(8);
+    return heavy == 0 && minors <= 1;
 }
 
 // Destructor
@@ -406,6 +432,9 @@ Board::~Board() {
 Board::Board(const Board& other) {
 	// Hash and history
     this->zobristKey = other.zobristKey;
+    this->sideToMove = other.sideToMove;
+    this->halfmoveClock = other.halfmoveClock;
+    this->materialKey = other.materialKey;
     this->positionHistory = other.positionHistory;
 
 	// Deep copy of squares
@@ -459,6 +488,9 @@ Board& Board::operator=(const Board& other) {
 
     // Perform copy
     this->zobristKey = other.zobristKey;
+    this->sideToMove = other.sideToMove;
+    this->halfmoveClock = other.halfmoveClock;
+    this->materialKey = other.materialKey;
     this->positionHistory = other.positionHistory;
 
     for (int r = 0; r < B_SIZE; r++) {
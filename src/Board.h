@@ -144,15 +144,47 @@ public:
 	 */
 	void promotePawn(Board &board, Position pos, char newSymbol, int color);
 	unsigned long long zobristKey = 0;
+	/**
+	 * @brief Board operation: side to move, 0 = White, 1 = Black (part of zobristKey).
+	 *
+	 */
+	int sideToMove = 0;
+	/**
+	 * @brief Board operation: plies since the last capture or pawn move (fifty-move rule).
+	 *
+	 */
+	int halfmoveClock = 0;
+	/**
+	 * @brief Board operation: material signature, 4 bits of piece count per getPieceIndex().
+	 *
+	 */
+	unsigned long long materialKey = 0;
 	/**
 	 * @brief Board operation: compute zobrist hash.
 	 *
 	 * @details Operates on the current board representation and game state.
+	 * Also rebuilds materialKey from the pieces on the board.
 	 */
 	void computeZobristHash();
+	/**
+	 * @brief Board operation: count pieces of one kind from the material signature.
+	 *
+	 * @param pieceIndex getPieceIndex() of the piece.
+	 * @return Number of such pieces on the board.
+	 */
+	int materialCount(int pieceIndex) const;
+	/**
+	 * @brief Board operation: check for a dead draw by material.
+	 *
+	 * @details K vs K and K + one minor piece vs K, read from materialKey in O(1).
+	 * @return true if neither side can ever mate.
+	 */
+	bool insufficientMaterial() const;
 	/**
 	 * @brief Board operation: store position history.
-	 * 
+	 *
+	 * @details Keys since the last irreversible move (capture or pawn move),
+	 * the last one is the current position. Older positions can never repeat.
 	 */
 	std::vector<unsigned long long> positionHistory;
 };
@@ -0,0 +1,263 @@
+/**
+ * @file bench.cpp
+ * @brief Engine benchmarks (Lazy SMP time-to-depth scaling, TT prefetch, resumable search).
+ * @version 0.1
+ * @date 2026-01-12
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <algorithm>
+#include <chrono>
+#include <cctype>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../Board.h"
+#include "../Pawn.h"
+#include "../Rook.h"
+#include "../kNight.h"
+#include "../Bishop.h"
+#include "../Queen.h"
+#include "../King.h"
+#include "../engine/search.h"
+#include "../engine/resumable.h"
+#include "../engine/tables/zobrist.h"
+#include "../engine/tables/TT.h"
+
+/**
+ * @brief Benchmark position: FEN piece placement field and side to move.
+ *
+ */
+struct BenchPosition {
+    const char* placement;
+    int color01;
+};
+
+static const BenchPosition positions[] = {
+    { "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR", 1 },                 // 1. e4
+    { "r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R", 0 },        // Two knights
+    { "r2q1rk1/pp2bppp/2np1n2/2p1p3/4P3/2PP1N2/PP1NBPPP/R2Q1RK1", 0 },      // Closed middlegame
+    { "8/2k5/3p4/p2P1p2/P4P2/8/3K4/8", 0 },                                  // Pawn endgame
+};
+
+/**
+ * @brief Place pieces from a FEN placement field (rank 8 first).
+ *
+ * @param board Empty board.
+ * @param placement FEN piece placement field.
+ * @param color01 Side to move, 0 = White, 1 = Black.
+ */
+static void loadPlacement(Board& board, const std::string& placement, int color01)
+{
+    int row = 7, col = 0;
+    for (char ch : placement) {
+        if (ch == '/') { --row; col = 0; continue; }
+        if (isdigit((unsigned char)ch)) { col += ch - '0'; continue; }
+        int color = isupper((unsigned char)ch) ? 0 : 1;
+        char symbol = (char)toupper((unsigned char)ch);
+        Position pos{ row, col++ };
+        switch (symbol) {
+        case 'P': board.placePiece(new Pawn(color, symbol, pos)); break;
+        case 'N': board.placePiece(new Knight(color, symbol, pos)); break;
+        case 'B': board.placePiece(new Bishop(color, symbol, pos)); break;
+        case 'R': board.placePiece(new Rook(color, symbol, pos)); break;
+        case 'Q': board.placePiece(new Queen(color, symbol, pos)); break;
+        case 'K': board.placePiece(new King(color, symbol, pos)); break;
+        }
+    }
+    board.sideToMove = color01;
+    board.computeZobristHash();
+    board.positionHistory.push_back(board.zobristKey);
+}
+
+/**
+ * @brief Time-to-depth scaling of the Lazy SMP pool.
+ *
+ * @details Every position is searched to a fixed depth with 1, 2, 4, 8 and 16
+ * threads, the TT is cleared before each run so runs do not help each other.
+ * An untimed warm-up pass first touches the lazily mapped TT pages, so the
+ * 1-thread baseline does not pay one-time costs the later rows skip. Each row
+ * keeps the best time of @p rounds runs.
+ * @param depth Fixed search depth.
+ * @param rounds Repetitions per thread count.
+ */
+static void benchSmp(int depth, int rounds)
+{
+    const int threadCounts[] = { 1, 2, 4, 8, 16 };
+    std::cout << "Lazy SMP time-to-depth, depth " << depth << "\n";
+    std::cout << std::setw(8) << "threads" << std::setw(12) << "time ms" << std::setw(14) << "nodes"
+        << std::setw(12) << "knps" << std::setw(10) << "speedup" << "\n";
+
+    SearchLimits limits;
+    limits.maxDepth = depth;
+    limits.timeLimitMs = 1000000;
+    {
+        SearchPool warmUp(1);
+        for (const auto& p : positions) {
+            Board board;
+            loadPlacement(board, p.placement, p.color01);
+            TT.clear();
+            warmUp.search(board, p.color01, limits);
+        }
+    }
+
+    double baseMs = 0;
+    for (int threads : threadCounts) {
+        double bestMs = 0;
+        long nodes = 0;
+        for (int round = 0; round < rounds; ++round) {
+            SearchPool pool(threads); // Fresh history tables per run
+            double totalMs = 0;
+            long totalNodes = 0;
+            for (const auto& p : positions) {
+                Board board;
+                loadPlacement(board, p.placement, p.color01);
+                TT.clear();
+
+                auto start = std::chrono::steady_clock::now();
+                SearchResult r = pool.search(board, p.color01, limits);
+                totalMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                totalNodes += r.nodes;
+            }
+            if (round == 0 || totalMs < bestMs) {
+                bestMs = totalMs;
+                nodes = totalNodes;
+            }
+        }
+        if (threads == 1) baseMs = bestMs;
+        std::cout << std::setw(8) << threads << std::setw(12) << std::fixed << std::setprecision(0) << bestMs
+            << std::setw(14) << nodes << std::setw(12) << (long)(nodes / (bestMs > 0 ? bestMs : 1))
+            << std::setw(10) << std::setprecision(2) << baseMs / bestMs << "\n";
+    }
+}
+
+/**
+ * @brief Single-thread nodes per second with and without TT prefetch.
+ *
+ * @details Both variants search the same positions to the same depth, so node
+ * counts match and only the time differs. Each variant runs @p rounds times,
+ * the best time is kept to reduce noise.
+ * @param depth Fixed search depth.
+ * @param rounds Repetitions per variant.
+ */
+static void benchPrefetch(int depth, int rounds)
+{
+    std::cout << "TT prefetch, 1 thread, depth " << depth << ", " << TT.sizeMB() << " MB TT\n";
+    std::cout << std::setw(10) << "prefetch" << std::setw(12) << "time ms" << std::setw(14) << "nodes"
+        << std::setw(12) << "knps" << "\n";
+
+    for (bool prefetch : { false, true }) {
+        double bestMs = 0;
+        long nodes = 0;
+        for (int round = 0; round < rounds; ++round) {
+            SearchPool pool(1); // Fresh history tables, every round searches the same trees
+            pool.setPrefetch(prefetch);
+            double totalMs = 0;
+            nodes = 0;
+            for (const auto& p : positions) {
+                Board board;
+                loadPlacement(board, p.placement, p.color01);
+                TT.clear();
+
+                SearchLimits limits;
+                limits.maxDepth = depth;
+                limits.timeLimitMs = 1000000;
+                auto start = std::chrono::steady_clock::now();
+                SearchResult r = pool.search(board, p.color01, limits);
+                totalMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                nodes += r.nodes;
+            }
+            if (round == 0 || totalMs < bestMs) bestMs = totalMs;
+        }
+        std::cout << std::setw(10) << (prefetch ? "on" : "off") << std::setw(12) << std::fixed << std::setprecision(0)
+            << bestMs << std::setw(14) << nodes << std::setw(12) << (long)(nodes / (bestMs > 0 ? bestMs : 1)) << "\n";
+    }
+}
+
+/**
+ * @brief Cost of the resumable search's coroutines and yield points.
+ *
+ * @details The plain single-thread SearchPool is the baseline. The resumable
+ * search runs the same tree (node counts match), first without yields (cost of
+ * the coroutine frames alone), then in slices of decreasing size. Best time of
+ * @p rounds runs per row.
+ * @param depth Fixed search depth.
+ * @param rounds Repetitions per row.
+ */
+static void benchResumable(int depth, int rounds)
+{
+    std::cout << "Resumable search, 1 thread, depth " << depth << "\n";
+    std::cout << std::setw(10) << "slice" << std::setw(12) << "time ms" << std::setw(14) << "nodes"
+        << std::setw(12) << "knps" << std::setw(10) << "slices" << "\n";
+
+    const long slices[] = { -1, 0, 16384, 4096, 1024, 256 }; // -1 = plain search
+    for (long slice : slices) {
+        double bestMs = 0;
+        long nodes = 0;
+        long steps = 0;
+        for (int round = 0; round < rounds; ++round) {
+            SearchPool pool(1);
+            ResumableSearch resumable(slice > 0 ? slice : 0);
+            double totalMs = 0;
+            nodes = 0;
+            steps = 0;
+            for (const auto& p : positions) {
+                Board board;
+                loadPlacement(board, p.placement, p.color01);
+                TT.clear();
+
+                SearchLimits limits;
+                limits.maxDepth = depth;
+                limits.timeLimitMs = 1000000;
+                auto start = std::chrono::steady_clock::now();
+                if (slice < 0) {
+                    nodes += pool.search(board, p.color01, limits).nodes;
+                }
+                else {
+                    resumable.start(board, p.color01, limits);
+                    while (!resumable.step()) {}
+                    nodes += resumable.result().nodes;
+                    steps += resumable.slices();
+                }
+                totalMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            }
+            if (round == 0 || totalMs < bestMs) bestMs = totalMs;
+        }
+        std::cout << std::setw(10) << (slice < 0 ? std::string("plain") : slice == 0 ? std::string("none") : std::to_string(slice))
+            << std::setw(12) << std::fixed << std::setprecision(0) << bestMs << std::setw(14) << nodes
+            << std::setw(12) << (long)(nodes / (bestMs > 0 ? bestMs : 1)) << std::setw(10) << steps << "\n";
+    }
+}
+
+/**
+ * @brief Run benchmarks.
+ *
+ * @details Usage: bench [smp|prefetch|resumable|all] [depth], default all at depth 7.
+ * A numeric first argument is the depth of all benchmarks (bench [depth]).
+ * @return 0 on success, 1 on an unknown mode.
+ */
+int main(int argc, char* argv[])
+{
+    std::string mode = argc > 1 ? argv[1] : "all";
+    std::string depthArg = argc > 2 ? argv[2] : "7";
+    if (!mode.empty() && std::isdigit((unsigned char)mode[0])) {
+        depthArg = mode;
+        mode = "all";
+    }
+    if (mode != "smp" && mode != "prefetch" && mode != "resumable" && mode != "all") {
+        std::cerr << "Unknown benchmark '" << mode << "'\n"
+            << "Usage: " << argv[0] << " [smp|prefetch|resumable|all] [depth]\n"
+            << "       " << argv[0] << " [depth]\n";
+        return 1;
+    }
+    int depth = std::max(1, std::atoi(depthArg.c_str()));
+
+    initZobrist();
+    if (mode == "smp" || mode == "all") benchSmp(depth, 3);
+    if (mode == "prefetch" || mode == "all") benchPrefetch(depth, 3);
+    if (mode == "resumable" || mode == "all") benchResumable(depth, 3);
+    return 0;
+}
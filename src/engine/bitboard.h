@@ -0,0 +1,247 @@
+/**
+ * @file bitboard.h
+ * @brief File declaration for bitboard helpers (attack tables, slider attacks, board snapshot).
+ * @version 0.1
+ * @date 2026-01-12
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+#include <array>
+#include <bit>
+#include <cctype>
+#include "../Board.h"
+
+/**
+ * @brief 64-bit set of squares, bit (row * 8 + col).
+ *
+ */
+using Bitboard = unsigned long long;
+
+/**
+ * @brief Piece type indices used by bitboards (same order as getPieceIndex() % 6).
+ *
+ */
+enum PieceType { PAWN = 0, KNIGHT, BISHOP, ROOK, QUEEN, KING, PIECE_TYPE_NB };
+
+/**
+ * @brief Bitboard with a single square set.
+ *
+ * @param sq Square index (row * 8 + col).
+ * @return Bitboard of the square.
+ */
+constexpr Bitboard squareBB(int sq) { return 1ULL << sq; }
+
+/**
+ * @brief Index of the least significant set bit.
+ *
+ * @param b Non-empty bitboard.
+ * @return Square index.
+ */
+inline int lsb(Bitboard b) { return std::countr_zero(b); }
+
+/**
+ * @brief Index of the most significant set bit.
+ *
+ * @param b Non-empty bitboard.
+ * @return Square index.
+ */
+inline int msb(Bitboard b) { return 63 - std::countl_zero(b); }
+
+/**
+ * @brief Map piece symbol to PieceType.
+ *
+ * @param symbol Piece symbol (any case).
+ * @return PieceType, PIECE_TYPE_NB for unknown symbols.
+ */
+inline int pieceTypeFromSymbol(char symbol) {
+    switch (toupper(symbol)) {
+    case 'P': return PAWN;
+    case 'N': return KNIGHT;
+    case 'B': return BISHOP;
+    case 'R': return ROOK;
+    case 'Q': return QUEEN;
+    case 'K': return KING;
+    default: return PIECE_TYPE_NB;
+    }
+}
+
+namespace bb_detail {
+    /**
+     * @brief Build a leaper attack table from (row, col) deltas.
+     */
+    template <int N>
+    constexpr std::array<Bitboard, 64> leaperTable(const int (&deltas)[N][2]) {
+        std::array<Bitboard, 64> table{};
+        for (int sq = 0; sq < 64; ++sq) {
+            int r = sq / 8, c = sq % 8;
+            for (int i = 0; i < N; ++i) {
+                int nr = r + deltas[i][0], nc = c + deltas[i][1];
+                if (nr >= 0 && nr < 8 && nc >= 0 && nc < 8)
+                    table[sq] |= squareBB(nr * 8 + nc);
+            }
+        }
+        return table;
+    }
+
+    constexpr int knightDeltas[8][2] = { {2, 1}, {1, 2}, {-1, 2}, {-2, 1}, {-2, -1}, {-1, -2}, {1, -2}, {2, -1} };
+    constexpr int kingDeltas[8][2] = { {1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}, {0, -1}, {1, -1} };
+    constexpr int whitePawnDeltas[2][2] = { {1, -1}, {1, 1} };   // White captures towards row + 1
+    constexpr int blackPawnDeltas[2][2] = { {-1, -1}, {-1, 1} }; // Black captures towards row - 1
+
+    // Ray directions: first four increase the square index, last four decrease it
+    constexpr int rayDeltas[8][2] = { {1, 0}, {0, 1}, {1, 1}, {1, -1}, {-1, 0}, {0, -1}, {-1, -1}, {-1, 1} };
+
+    constexpr std::array<std::array<Bitboard, 64>, 8> rayTable() {
+        std::array<std::array<Bitboard, 64>, 8> rays{};
+        for (int d = 0; d < 8; ++d)
+            for (int sq = 0; sq < 64; ++sq) {
+                int r = sq / 8 + rayDeltas[d][0], c = sq % 8 + rayDeltas[d][1];
+                while (r >= 0 && r < 8 && c >= 0 && c < 8) {
+                    rays[d][sq] |= squareBB(r * 8 + c);
+                    r += rayDeltas[d][0];
+                    c += rayDeltas[d][1];
+                }
+            }
+        return rays;
+    }
+}
+
+/**
+ * @brief Knight attacks from each square.
+ *
+ */
+inline constexpr std::array<Bitboard, 64> knightAttacks = bb_detail::leaperTable(bb_detail::knightDeltas);
+/**
+ * @brief King attacks from each square.
+ *
+ */
+inline constexpr std::array<Bitboard, 64> kingAttacks = bb_detail::leaperTable(bb_detail::kingDeltas);
+/**
+ * @brief Pawn attacks [color][square]: squares attacked by a pawn of color standing on square.
+ *
+ */
+inline constexpr std::array<Bitboard, 64> pawnAttacks[2] = {
+    bb_detail::leaperTable(bb_detail::whitePawnDeltas),
+    bb_detail::leaperTable(bb_detail::blackPawnDeltas)
+};
+/**
+ * @brief Empty-board rays [direction][square], see bb_detail::rayDeltas.
+ *
+ */
+inline constexpr std::array<std::array<Bitboard, 64>, 8> rayAttacks = bb_detail::rayTable();
+
+/**
+ * @brief Attacks along one ray, stopping at (and including) the first blocker.
+ *
+ * @param dir Ray direction index (0..3 increasing squares, 4..7 decreasing).
+ * @param sq Origin square.
+ * @param occ Occupied squares.
+ * @return Attacked squares.
+ */
+inline Bitboard rayAttack(int dir, int sq, Bitboard occ) {
+    Bitboard ray = rayAttacks[dir][sq];
+    Bitboard blockers = ray & occ;
+    if (blockers) {
+        int b = dir < 4 ? lsb(blockers) : msb(blockers);
+        ray ^= rayAttacks[dir][b];
+    }
+    return ray;
+}
+
+/**
+ * @brief Bishop attacks for a given occupancy.
+ *
+ * @param sq Origin square.
+ * @param occ Occupied squares.
+ * @return Attacked squares.
+ */
+inline Bitboard bishopAttacks(int sq, Bitboard occ) {
+    return rayAttack(2, sq, occ) | rayAttack(3, sq, occ) | rayAttack(6, sq, occ) | rayAttack(7, sq, occ);
+}
+
+/**
+ * @brief Rook attacks for a given occupancy.
+ *
+ * @param sq Origin square.
+ * @param occ Occupied squares.
+ * @return Attacked squares.
+ */
+inline Bitboard rookAttacks(int sq, Bitboard occ) {
+    return rayAttack(0, sq, occ) | rayAttack(1, sq, occ) | rayAttack(4, sq, occ) | rayAttack(5, sq, occ);
+}
+
+/**
+ * @brief Squares strictly between two squares on a line.
+ *
+ * @param s1 First square.
+ * @param s2 Second square.
+ * @return Squares between them, empty if they do not share a rank, file or diagonal.
+ */
+inline Bitboard betweenBB(int s1, int s2) {
+    for (int dir = 0; dir < 8; ++dir)
+        if (rayAttacks[dir][s1] & squareBB(s2))
+            return rayAttacks[dir][s1] & ~rayAttacks[dir][s2] & ~squareBB(s2);
+    return 0;
+}
+
+/**
+ * @brief Bitboard snapshot of a Board (one pass over the squares array).
+ *
+ */
+struct BoardBitboards {
+    Bitboard byColor[2] = { 0, 0 };
+    Bitboard byType[PIECE_TYPE_NB] = { 0, 0, 0, 0, 0, 0 };
+    Bitboard occupied = 0;
+
+    /**
+     * @brief Empty snapshot.
+     *
+     */
+    BoardBitboards() = default;
+
+    /**
+     * @brief Build the snapshot from the squares array.
+     *
+     * @param board Board state.
+     */
+    explicit BoardBitboards(const Board& board) {
+        for (int r = 0; r < 8; ++r)
+            for (int c = 0; c < 8; ++c) {
+                const Piece* p = board.squares[r][c];
+                if (!p) continue;
+                int type = pieceTypeFromSymbol(p->symbol);
+                if (type == PIECE_TYPE_NB) continue;
+                Bitboard b = squareBB(r * 8 + c);
+                byColor[p->color] |= b;
+                byType[type] |= b;
+                occupied |= b;
+            }
+    }
+
+    /**
+     * @brief Pieces of one type and color.
+     *
+     * @param color 0 = White, 1 = Black.
+     * @param type PieceType.
+     * @return Bitboard of those pieces.
+     */
+    Bitboard pieces(int color, int type) const { return byColor[color] & byType[type]; }
+
+    /**
+     * @brief All pieces (both colors) attacking @p sq for a given occupancy.
+     *
+     * @param sq Target square.
+     * @param occ Occupancy used for slider blocking (pieces removed from it reveal x-rays).
+     * @return Attackers bitboard, may include pieces not in @p occ (mask it if needed).
+     */
+    Bitboard attackersTo(int sq, Bitboard occ) const {
+        return (pawnAttacks[1][sq] & pieces(0, PAWN))
+            | (pawnAttacks[0][sq] & pieces(1, PAWN))
+            | (knightAttacks[sq] & byType[KNIGHT])
+            | (kingAttacks[sq] & byType[KING])
+            | (bishopAttacks(sq, occ) & (byType[BISHOP] | byType[QUEEN]))
+            | (rookAttacks(sq, occ) & (byType[ROOK] | byType[QUEEN]));
+    }
+};
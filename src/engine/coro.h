@@ -0,0 +1,67 @@
+/**
+ * @file coro.h
+ * @brief File declaration for the coroutine task type of the resumable search.
+ * @version 0.1
+ * @date 2026-01-12
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+/**
+ * @brief Lazily started coroutine returning a score, awaitable from another SearchCoro.
+ *
+ * @details Awaiting a child transfers control to it and its completion transfers
+ * back to the parent (symmetric transfer), so a chain of nested searches never
+ * grows the native stack. A node that suspends without a successor (see
+ * Engine::negamaxResumable()) returns control to whoever resumed the chain.
+ */
+struct SearchCoro {
+    struct promise_type {
+        int value = 0;
+        std::coroutine_handle<> parent; // Resumed on completion, empty for the top-level task
+
+        SearchCoro get_return_object() { return SearchCoro(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        struct FinalAwaiter {
+            bool await_ready() noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) noexcept {
+                std::coroutine_handle<> p = h.promise().parent;
+                return p ? p : std::noop_coroutine();
+            }
+            void await_resume() noexcept {}
+        };
+        FinalAwaiter final_suspend() noexcept { return {}; }
+
+        void return_value(int v) { value = v; }
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    std::coroutine_handle<promise_type> handle;
+
+    SearchCoro() = default;
+    explicit SearchCoro(std::coroutine_handle<promise_type> h) : handle(h) {}
+    SearchCoro(SearchCoro&& other) noexcept : handle(std::exchange(other.handle, {})) {}
+    SearchCoro& operator=(SearchCoro&& other) noexcept {
+        if (this != &other) {
+            if (handle) handle.destroy();
+            handle = std::exchange(other.handle, {});
+        }
+        return *this;
+    }
+    SearchCoro(const SearchCoro&) = delete;
+    SearchCoro& operator=(const SearchCoro&) = delete;
+    ~SearchCoro() { if (handle) handle.destroy(); }
+
+    bool await_ready() const noexcept { return false; }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        handle.promise().parent = awaiting;
+        return handle;
+    }
+    int await_resume() const noexcept { return handle.promise().value; }
+};
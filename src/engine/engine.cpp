@@ -17,22 +17,55 @@
 #include <string>
 #include "tables/zobrist.h"
 #include "tables/TT.h"
+#include "tables/cuckoo.h"
 #include "engine.h"
+#include "params.h"
+#include "see.h"
+#include "bitboard.h"
 #include <cctype> // Necessary for toupper
 
-// count nodes visited by negamax
-static long nodesVisited = 0;
 /**
  * @brief Returns the number of nodes visited by the search.
  *
  * This counter is incremented in Engine::negamax() (and optionally in quiescence,
  * depending on your design). It is useful for profiling and debugging performance.
+ * Every Engine instance (one per search thread) has its own counter.
  *
  * @return Total number of visited nodes since last reset (or since program start
  *         if you do not reset the counter).
  */
 long Engine::get_nodes_visited() { return nodesVisited; }
 
+/**
+ * @brief Checks whether the search driver asked this engine to stop.
+ *
+ * @return true if the shared stop flag is set.
+ */
+bool Engine::stopRequested() const
+{
+    return stopFlag && stopFlag->load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Stops the search when the hard time limit has passed.
+ *
+ * Called on every node, reads the clock only every TIME_CHECK_NODES nodes.
+ * Setting the shared stop flag also stops the helper threads, every node
+ * then returns immediately and the driver falls back to the last completed
+ * iteration.
+ */
+void Engine::pollTime()
+{
+    if ((nodesVisited & (TIME_CHECK_NODES - 1)) != 0)
+        return;
+    if (nodeCounter) {
+        long nodes = nodeCounter->fetch_add(TIME_CHECK_NODES, std::memory_order_relaxed) + TIME_CHECK_NODES;
+        if (progress) progress->setNodes(nodes);
+    }
+    if (timer && stopFlag && timer->hardExpired())
+        stopFlag->store(true, std::memory_order_relaxed);
+}
+
 
 /**
  * @brief Converts side sign (+1/-1) to 0/1 color encoding.
@@ -120,6 +153,9 @@ void Engine::undoMove(Board& board, const Move& move, const Undo& undo)
 
     // Revert side
     board.zobristKey ^= sideKey;
+    board.sideToMove ^= 1;
+    board.halfmoveClock = undo.halfmoveClock;
+    board.materialKey = undo.materialKey;
 
     // Bring back the Zobrist key
     if (move.promotion != 0) {
@@ -150,21 +186,25 @@ void Engine::undoMove(Board& board, const Move& move, const Undo& undo)
  *   - XOR out captured piece from to-square (if any),
  *   - XOR in moved/promoted piece on to-square,
  *   - XOR side-to-move key.
+ * - Updates halfmoveClock (reset by captures and pawn moves) and the material signature.
  * - Handles promotion by changing the moved piece symbol to @p move.promotion.
  *
  * @param board Board state to mutate.
  * @param move Move to apply.
  * @param undo Output snapshot used later by undoMove().
+ * @param prefetch Prefetch the child's TT cluster (false for legality checks, no probe follows).
  *
  * @note This function assumes Piece pointers live outside and are not owned here.
  */
-void Engine::applyMove(Board& board, const Move& move, Undo& undo)
+void Engine::applyMove(Board& board, const Move& move, Undo& undo, bool prefetch)
 {
     undo.from = move.from;
     undo.to = move.to;
     undo.pieceMoved = board.getPieceAt(move.from);
     undo.pieceCaptured = board.getPieceAt(move.to); // Might be nullptr
     undo.promotion = move.promotion;
+    undo.halfmoveClock = board.halfmoveClock;
+    undo.materialKey = board.materialKey;
 
     int fromSq = move.from.row * 8 + move.from.col;
     int toSq = move.to.row * 8 + move.to.col;
@@ -178,13 +218,18 @@ void Engine::applyMove(Board& board, const Move& move, Undo& undo)
     if (undo.pieceCaptured) {
         int capIdx = getPieceIndex(undo.pieceCaptured->getSymbol(), undo.pieceCaptured->getColor());
         board.zobristKey ^= pieceKeys[capIdx][toSq];
+        board.materialKey -= 1ULL << (4 * capIdx);
     }
 
+    // Captures and pawn moves reset the fifty-move counter
+    board.halfmoveClock = (undo.pieceCaptured || p->getSymbol() == 'P') ? 0 : board.halfmoveClock + 1;
+
     // Zobrist insert piece
     // If promoted put new figure
     if (move.promotion != 0) {
         int promoIdx = getPieceIndex(move.promotion, p->getColor());
         board.zobristKey ^= pieceKeys[promoIdx][toSq];
+        board.materialKey += (1ULL << (4 * promoIdx)) - (1ULL << (4 * pIdx));
     }
     else {
         board.zobristKey ^= pieceKeys[pIdx][toSq];
@@ -192,6 +237,11 @@ void Engine::applyMove(Board& board, const Move& move, Undo& undo)
 
     // Switch side
     board.zobristKey ^= sideKey;
+    board.sideToMove ^= 1;
+
+    // Child key is known: start loading its TT cluster while the move is applied
+    if (prefetch && prefetchTT)
+        TT.prefetch(board.zobristKey);
 
     // Raw move application
     // Delete piece
@@ -490,7 +540,7 @@ std::vector<Move> Engine::legalMoves(Board& board, int color) {
     // Check if moves leave king in check
     for (auto& move : quiet) {
         Undo undo;
-        applyMove(board, move, undo); // Try move
+        applyMove(board, move, undo, false); // Try move
 
         // Is king in check after move?
         if (!isInCheck(board, color)) {
@@ -517,12 +567,12 @@ static std::vector<Move> generateCaptures(Board& board, int color)
     return generateAllCaptures(board, color);
 }
 /**
- * @brief Score a move for move ordering.
+ * @brief Score a capture or promotion for move ordering.
  * 
  * @param move Move to score.
- * @return int Score value.
+ * @return int Score value, 0 for quiet moves.
  */
-static int scoreMove(const Move& move) {
+static int scoreTacticalMove(const Move& move) {
     // CAPTURES (MVV-LVA)
     if (move.pieceCaptured != nullptr) {
         int victimVal = pieceValFromSymbol(move.pieceCaptured->getSymbol());
@@ -558,10 +608,172 @@ void Engine::orderMoves(std::vector<Move>& moves)
 {
     // Sort descending by score
     std::sort(moves.begin(), moves.end(), [](const Move& a, const Move& b) {
-        return scoreMove(a) > scoreMove(b);
+        return scoreTacticalMove(a) > scoreTacticalMove(b);
         });
 }
 
+/**
+ * @brief Records the move made at @p ply in the search stack.
+ *
+ * Children read stack[ply] (previous move) and stack[ply - 1] (move before it)
+ * to index countermoves and continuation history.
+ *
+ * @param ply Distance from the root.
+ * @param move Move about to be searched.
+ */
+void Engine::recordMove(int ply, const Move& move)
+{
+    if (ply < 0 || ply > MAX_PLY) return;
+    stack[ply].pieceIdx = getPieceIndex(move.pieceMoved->getSymbol(), move.pieceMoved->getColor());
+    stack[ply].toSq = move.to.row * 8 + move.to.col;
+}
+
+/**
+ * @brief Checks whether a capture loses material according to SEE.
+ *
+ * Captures of an equal or more valuable piece can never lose material, so
+ * SEE is only computed when the attacker is worth more than the victim.
+ * Promotions are never treated as losing.
+ *
+ * @param bb Bitboard snapshot of the position.
+ * @param move Capture to check.
+ * @return true if SEE of the capture is negative.
+ */
+static bool isLosingCapture(const BoardBitboards& bb, const Move& move)
+{
+    if (move.promotion != 0 || move.pieceCaptured == nullptr) return false;
+    int victimVal = pieceValFromSymbol(move.pieceCaptured->getSymbol());
+    int attackerVal = pieceValFromSymbol(move.pieceMoved->getSymbol());
+    if (attackerVal <= victimVal) return false;
+    return seeMove(bb, move) < 0;
+}
+
+/**
+ * @brief Scores a move for search ordering.
+ *
+ * Layers (highest first):
+ * - good captures / promotions (MVV-LVA, promotion bonus),
+ * - killer moves of this ply (slot 0 before slot 1),
+ * - countermove of the previous move,
+ * - remaining quiet moves by butterfly history plus continuation history
+ *   of the move pairs (previous move, move) and (move two plies ago, move),
+ * - bad captures (negative SEE), still MVV-LVA among themselves.
+ *
+ * @param bb Bitboard snapshot of the position (used for SEE of captures).
+ * @param move Move to score.
+ * @param ply Distance from the root.
+ * @param color01 Side to move (0 = White, 1 = Black).
+ * @return Ordering score, higher is searched first.
+ */
+int Engine::scoreMove(const BoardBitboards& bb, const Move& move, int ply, int color01)
+{
+    int tactical = scoreTacticalMove(move);
+    if (tactical > 0) {
+        if (isLosingCapture(bb, move)) return -200000 + tactical;
+        return 1000000 + tactical;
+    }
+
+    int slot = history.killerSlot(ply, move);
+    if (slot == 0) return 900000;
+    if (slot == 1) return 899000;
+
+    const StackEntry* prev = (ply >= 1 && ply <= MAX_PLY) ? &stack[ply - 1] : nullptr;
+    const StackEntry* prev2 = (ply >= 2 && ply <= MAX_PLY) ? &stack[ply - 2] : nullptr;
+
+    if (prev && sameMove(history.counterMove(prev->pieceIdx, prev->toSq), move))
+        return 898000;
+
+    int score = history.get(color01, move);
+    int pc = getPieceIndex(move.pieceMoved->getSymbol(), color01);
+    int to = move.to.row * 8 + move.to.col;
+    if (prev) score += history.getContinuation(prev->pieceIdx, prev->toSq, pc, to);
+    if (prev2) score += history.getContinuation(prev2->pieceIdx, prev2->toSq, pc, to);
+    return score;
+}
+
+/**
+ * @brief Orders moves using the TT move, captures, promotions, killers and history.
+ *
+ * Scores are computed once per move and the list is insertion-sorted
+ * (move lists are short, so this beats re-scoring inside std::sort).
+ * One bitboard snapshot is built per call and shared by all SEE lookups.
+ * The TT move (best move of an earlier visit) goes first.
+ *
+ * @param board Board state (used for SEE of captures).
+ * @param moves Move list to reorder in-place.
+ * @param ply Distance from the root.
+ * @param color01 Side to move (0 = White, 1 = Black).
+ * @param ttMove Best move stored in the TT (from.row == -1 if none).
+ */
+void Engine::orderMoves(Board& board, std::vector<Move>& moves, int ply, int color01, const Move& ttMove)
+{
+    const int n = (int)moves.size();
+    std::vector<int> scores(n);
+    BoardBitboards bb(board);
+    bool hasTTMove = ttMove.from.row >= 0;
+    for (int i = 0; i < n; ++i)
+        scores[i] = hasTTMove && sameMove(moves[i], ttMove) ? 2000000 : scoreMove(bb, moves[i], ply, color01);
+
+    for (int i = 1; i < n; ++i) {
+        Move m = moves[i];
+        int s = scores[i];
+        int j = i - 1;
+        while (j >= 0 && scores[j] < s) {
+            moves[j + 1] = moves[j];
+            scores[j + 1] = scores[j];
+            --j;
+        }
+        moves[j + 1] = m;
+        scores[j + 1] = s;
+    }
+}
+
+/**
+ * @brief Updates quiet ordering tables after a quiet beta cutoff.
+ *
+ * The cutoff move becomes a killer of this ply and the countermove of the
+ * previous move, and gets a depth^2 bonus in butterfly history and in the
+ * continuation history of both earlier moves on the search stack.
+ * Quiet moves searched before it get the same amount as a malus, since they
+ * failed to produce the cutoff.
+ *
+ * @param move Quiet move that caused the cutoff.
+ * @param quietsTried Quiet moves searched before @p move.
+ * @param depth Remaining depth of the node.
+ * @param ply Distance from the root.
+ * @param color01 Side to move (0 = White, 1 = Black).
+ */
+void Engine::updateQuietStats(const Move& move, const std::vector<Move>& quietsTried, int depth, int ply, int color01)
+{
+    int bonus = depth * depth;
+    const StackEntry* prev = (ply >= 1 && ply <= MAX_PLY) ? &stack[ply - 1] : nullptr;
+    const StackEntry* prev2 = (ply >= 2 && ply <= MAX_PLY) ? &stack[ply - 2] : nullptr;
+
+    auto updateMove = [&](const Move& m, int amount) {
+        history.update(color01, m, amount);
+        int pc = getPieceIndex(m.pieceMoved->getSymbol(), color01);
+        int to = m.to.row * 8 + m.to.col;
+        if (prev) history.updateContinuation(prev->pieceIdx, prev->toSq, pc, to, amount);
+        if (prev2) history.updateContinuation(prev2->pieceIdx, prev2->toSq, pc, to, amount);
+        };
+
+    history.storeKiller(ply, move);
+    if (prev) history.storeCounterMove(prev->pieceIdx, prev->toSq, move);
+    updateMove(move, bonus);
+    for (const Move& quiet : quietsTried)
+        updateMove(quiet, -bonus);
+}
+
+/**
+ * @brief Prepares ordering tables for a new search.
+ *
+ * History is halved (aging) rather than cleared, killers are reset.
+ */
+void Engine::newSearch()
+{
+    history.age();
+}
+
 // game over if one king is missing
 /**
  * @brief Perform game over.
@@ -598,78 +810,401 @@ static bool gameOver(const Board& board)
  * instead of returning a static evaluation immediately.
  *
  * Algorithm:
- * - Compute a "stand pat" evaluation.
+ * - Probe the TT (depth 0 entries are quiescence results, deeper ones are also usable).
+ * - Compute a "stand pat" evaluation (reused from the TT entry when present).
  * - If stand pat >= beta: fail-high cutoff.
- * - Else try all capture moves:
+ * - Else try all capture moves that do not lose material (SEE >= 0) and can
+ *   still raise alpha (delta pruning: stand pat + victim + DELTA_MARGIN > alpha):
  *     score = -quiescence(child, -beta, -alpha, -color)
+ * - Store the result as a depth 0 TT entry.
  * - Return best score within [alpha, beta].
  *
  * @param board Board state (mutated via apply/undo).
  * @param alpha Alpha bound.
  * @param beta Beta bound.
  * @param color Perspective sign (+1 = White perspective, -1 = Black perspective).
+ * @param ply Distance from the root (mate score conversion of TT entries).
  * @return Best tactical score in the quiescence search window.
  */
-int Engine::quiescence(Board& board, int alpha, int beta, int color)
+int Engine::quiescence(Board& board, int alpha, int beta, int color, int ply)
 {
-    int stand = eval(board, color);
-    if (stand >= beta)
+    if (stopRequested())
+        return 0; // Result is discarded by the search driver
+    ++nodesVisited;
+    pollTime();
+
+    int ttScore;
+    int ttEval;
+    Move ttMove{ {-1,-1}, {-1,-1}, nullptr, nullptr };
+    unsigned long long key = board.zobristKey;
+    if (TT.probe(key, 0, alpha, beta, ttScore, ttMove, &ttEval, ply))
+        return ttScore;
+
+    int stand = ttEval != TT_EVAL_NONE ? ttEval : eval(board, color);
+    if (stand >= beta) {
+        TT.store(key, beta, 0, TT_BETA, ttMove, stand, ply);
         return beta;
+    }
+    int oldAlpha = alpha;
     if (stand > alpha)
         alpha = stand;
 
     auto caps = generateCaptures(board, to01(color));
+    if (caps.empty()) {
+        TT.store(key, alpha, 0, alpha > oldAlpha ? TT_EXACT : TT_ALPHA, ttMove, stand, ply);
+        return alpha;
+    }
     // Only consider capture moves
     orderMoves(caps);
+    if (ttMove.from.row >= 0) {
+        for (size_t i = 0; i < caps.size(); ++i)
+            if (sameMove(caps[i], ttMove)) {
+                std::rotate(caps.begin(), caps.begin() + i, caps.begin() + i + 1);
+                break;
+            }
+    }
+    BoardBitboards bb(board);
+    Move bestMove{ {-1,-1}, {-1,-1}, nullptr, nullptr };
     for (auto& move : caps)
     {
+        // Delta pruning: even winning the victim for free stays below alpha
+        if (move.promotion == 0 && move.pieceCaptured
+            && stand + pieceValFromSymbol(move.pieceCaptured->getSymbol()) + DELTA_MARGIN <= alpha)
+            continue;
+
+        // Losing captures cannot improve on stand pat
+        if (isLosingCapture(bb, move))
+            continue;
+
         Undo undo;
         applyMove(board, move, undo);
 
-        int score = -quiescence(board, -beta, -alpha, -color);
+        int score = -quiescence(board, -beta, -alpha, -color, ply + 1);
         undoMove(board, move, undo);
-        if (score >= beta)
+        if (stopRequested())
+            return 0;
+        if (score >= beta) {
+            TT.store(key, beta, 0, TT_BETA, move, stand, ply);
             return beta;
-        if (score > alpha)
+        }
+        if (score > alpha) {
             alpha = score;
+            bestMove = move;
+        }
     }
+    TT.store(key, alpha, 0, alpha > oldAlpha ? TT_EXACT : TT_ALPHA, bestMove, stand, ply);
     return alpha;
 }
 
 /**
  * @brief Checks whether the current position repeats (threefold-style loop prevention).
  *
- * Uses Zobrist keys stored in board.positionHistory and compares them against
- * the current board.zobristKey.
+ * The repetition stack holds the game history followed by the search path, so
+ * cycles inside the tree are found too. Only positions with the same side to
+ * move within the halfmove clock are compared (see RepetitionStack).
  *
- * @param board Board state (must contain a valid zobristKey and positionHistory).
- * @return true if the current zobristKey appeared before in the history, otherwise false.
+ * @return true if the current position appeared before, otherwise false.
  *
  * @note This is often used to discourage draw loops or to return a draw-ish score.
  */
-bool Engine::isRepetition(const Board& board) {
-    // Move is a repetition if current zobristKey appeared before in positionHistory
-    for (int i = board.positionHistory.size() - 1; i >= 0; --i) {
-        if (board.positionHistory[i] == board.zobristKey) {
+bool Engine::isRepetition() const {
+    return repetitions.repeated();
+}
+
+/**
+ * @brief Detects that the side to move can force a repetition with one move.
+ *
+ * The key difference between the current position and one an odd number of
+ * plies back is looked up in the cuckoo table of reversible moves. A hit with
+ * no piece between the two squares means one move restores that position, so
+ * the move list does not have to be generated to find it.
+ *
+ * - Cycles inside the search tree count after a single occurrence.
+ * - Cycles reaching into the game history need the moving piece to belong to
+ *   the side to move and the earlier position to have repeated already.
+ *
+ * @param board Board state (its position is the top of the repetition stack).
+ * @param ply Distance from the root.
+ * @return true if a repetition is one move away.
+ */
+bool Engine::upcomingRepetition(const Board& board, int ply) const
+{
+    const auto& entries = repetitions.entries;
+    int top = (int)entries.size() - 1;
+    if (top < 3) return false;
+    int window = std::min(entries[top].clock, top);
+
+    for (int i = 3; i <= window; i += 2) {
+        int slot = cuckooFind(entries[top].key ^ entries[top - i].key);
+        if (slot < 0) continue;
+
+        int s1 = cuckooMoves[slot] & 63;
+        int s2 = cuckooMoves[slot] >> 6;
+        bool blocked = false;
+        for (Bitboard b = betweenBB(s1, s2); b && !blocked; b &= b - 1) {
+            int sq = lsb(b);
+            blocked = board.squares[sq / 8][sq % 8] != nullptr;
+        }
+        if (blocked) continue;
+
+        if (ply > i) return true;
+
+        // The cuckoo slot holds both directions, the moving piece sits on the occupied square
+        const Piece* p = board.squares[s1 / 8][s1 % 8] ? board.squares[s1 / 8][s1 % 8] : board.squares[s2 / 8][s2 % 8];
+        if (!p || p->color != board.sideToMove) continue;
+        if (repetitions.repeatedAt(top - i)) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief First phase of a negamax node: everything before the move loop.
+ *
+ * @details Steps 1) to 4) of negamax(): draws and repetitions, mate distance
+ * pruning, TT probe, quiescence at the horizon, leaf pruning, move generation,
+ * IIR and move ordering.
+ * @param board Board state.
+ * @param node Node state, bounds and depth are updated in place.
+ * @return True if the node is resolved without a move loop, score in node.result.
+ */
+bool Engine::enterNode(Board& board, Node& node)
+{
+    int& alpha = node.alpha;
+    int& beta = node.beta;
+    int color = node.color;
+    int ply = node.ply;
+    node.staticEval = TT_EVAL_NONE;
+    node.best = -INF;
+
+    if (stopRequested()) {
+        node.result = 0; // Result is discarded by the search driver
+        return true;
+    }
+
+    if (ply > 0 && isRepetition()) {
+        // 0 is equal position, slight minus for engine to avoid repetition
+        node.result = REPETITION_SCORE;
+        return true;
+    }
+
+    // Dead draws: fifty-move rule and material that cannot mate
+    if (ply > 0 && board.insufficientMaterial()) {
+        node.result = 0;
+        return true;
+    }
+    if (ply > 0 && board.halfmoveClock >= 100) {
+        // A checkmate delivered on the hundredth half-move still wins
+        bool mated = isInCheck(board, to01(color)) && legalMoves(board, to01(color)).empty();
+        node.result = mated ? -MATE_SCORE + ply : 0;
+        return true;
+    }
+
+    // Side to move can play into a repetition, which is worth at least the negated score
+    if (ply > 0 && alpha < -REPETITION_SCORE && upcomingRepetition(board, ply)) {
+        alpha = -REPETITION_SCORE;
+        if (alpha >= beta) {
+            node.result = alpha;
             return true;
-            // Repetition found
         }
     }
+
+    // Mate distance pruning: a mate found closer to the root already bounds this node
+    alpha = std::max(alpha, -MATE_SCORE + ply);
+    beta = std::min(beta, MATE_SCORE - ply - 1);
+    if (alpha >= beta) {
+        node.result = alpha;
+        return true;
+    }
+
+    // Horizon: quiescence counts the node and probes the TT with the same key and window itself
+    if (node.depth == 0) {
+        node.result = quiescence(board, alpha, beta, color, ply);
+        return true;
+    }
+
+    ++nodesVisited;
+    pollTime();
+
+    int ttScore;
+    int ttEval;
+    Move ttMove{ {-1,-1}, {-1,-1}, nullptr, nullptr };
+    // Read hash
+    node.key = board.zobristKey;
+    if (TT.probe(node.key, node.depth, alpha, beta, ttScore, ttMove, &ttEval, ply)) {
+        node.result = ttScore; // Score found in TT, immediately return
+        return true;
+    }
+
+    if (gameOver(board)) {
+        node.result = quiescence(board, alpha, beta, color, ply);
+        return true;
+    }
+
+    node.inCheck = isInCheck(board, to01(color));
+    // PVS gives a full window to principal variation nodes only, all other nodes get a null window
+    node.pvNode = beta - alpha > 1;
+
+    // Leaf pruning, only outside check and away from mate scores
+    if (!node.inCheck && node.depth <= PRUNING_MAX_DEPTH) {
+        int depth = node.depth;
+        int staticEval = ttEval != TT_EVAL_NONE ? ttEval : eval(board, color); // Reuse eval stored by an earlier visit
+        node.staticEval = staticEval;
+
+        // Reverse futility pruning (static null move):
+        // far above beta, assume the opponent cannot catch up in a few plies.
+        // Not at PV nodes, their exact score is needed
+        if (!node.pvNode && beta < MATE_BOUND && staticEval - reverseFutilityMargin[depth] >= beta) {
+            node.result = staticEval;
+            return true;
+        }
+
+        if (alpha > -MATE_BOUND && alpha < MATE_BOUND) {
+            // Razoring: far below alpha, verify with quiescence and give up if it fails low
+            if (staticEval + razorMargin[depth] < alpha) {
+                int q = quiescence(board, alpha - 1, alpha, color, ply);
+                if (q < alpha) {
+                    node.result = q;
+                    return true;
+                }
+            }
+            // Futility: quiet moves cannot lift the score over alpha
+            node.futile = staticEval + futilityMargin[depth] <= alpha;
+        }
+    }
+
+    node.moves = legalMoves(board, to01(color));
+
+    if (node.moves.empty()) {
+        // No legal moves, check for checkmate or stalemate
+        node.result = node.inCheck ? -MATE_SCORE + ply : 0; // CHECKMATE (mated in ply half-moves from the root) or STALEMATE
+        return true;
+    }
+
+    // Internal iterative reduction: a PV node without a TT move is likely badly
+    // ordered, search it shallower and let the next iteration find the move
+    if (node.pvNode && ttMove.from.row < 0 && node.depth >= IIR_MIN_DEPTH)
+        --node.depth;
+
+    orderMoves(board, node.moves, ply, to01(color), ttMove);
+
+    // Snapshot for SEE pruning, board is restored after every move so it stays valid
+    node.seePruning = !node.inCheck && node.depth <= PRUNING_MAX_DEPTH;
+    if (node.seePruning) node.bb = BoardBitboards(board);
+
+    // For TT storage
+    node.oldAlpha = alpha;
     return false;
 }
 
+/**
+ * @brief Prune or make one move of the node's move loop.
+ *
+ * @param board Board state.
+ * @param node Node state.
+ * @param move Move to try.
+ * @param undo Receives the undo data if the move is made.
+ * @return True if the move was made and its child must be searched, false if it was pruned.
+ */
+bool Engine::enterChild(Board& board, Node& node, const Move& move, Undo& undo)
+{
+    // SEE pruning of quiet moves that hang the moved piece
+    if (node.seePruning && node.movesSearched > 0 && node.best > -MATE_BOUND
+        && isQuiet(move) && seeMove(node.bb, move) < seeQuietThreshold[node.depth])
+        return false;
+
+    recordMove(node.ply, move);
+    applyMove(board, move, undo);
+
+    // Futility pruning of quiet moves that do not give check
+    if (node.futile && node.movesSearched > 0 && isQuiet(move) && !isInCheck(board, to01(-node.color))) {
+        undoMove(board, move, undo);
+        return false;
+    }
+
+    ++node.movesSearched;
+    repetitions.push(board.zobristKey, board.halfmoveClock);
+    return true;
+}
+
+/**
+ * @brief Take back a searched move and update the node's bounds.
+ *
+ * @param board Board state.
+ * @param node Node state.
+ * @param move Move that was searched.
+ * @param undo Undo data of the move.
+ * @param score Score of the child, from the node's perspective.
+ * @return True if the move loop ends (beta cutoff or stop request).
+ */
+bool Engine::leaveChild(Board& board, Node& node, const Move& move, const Undo& undo, int score)
+{
+    repetitions.pop();
+    undoMove(board, move, undo);
+    if (stopRequested()) {
+        node.stopped = true; // Interrupted subtree, do not store a partial result
+        return true;
+    }
+    if (score > node.best) {
+        node.best = score;
+        node.bestMove = move;
+    }
+    if (score > node.alpha)
+        node.alpha = score;
+    if (node.alpha >= node.beta) {
+        // beta cutoff, remember quiet move for ordering siblings
+        if (isQuiet(move))
+            updateQuietStats(move, node.quietsTried, node.depth, node.ply, to01(node.color));
+        return true;
+    }
+    if (isQuiet(move))
+        node.quietsTried.push_back(move);
+    return false;
+}
+
+/**
+ * @brief Last phase of a negamax node: store the result in the TT.
+ *
+ * @param node Node state after the move loop.
+ * @return Best score of the node, 0 if the search was stopped.
+ */
+int Engine::leaveNode(Node& node)
+{
+    if (node.stopped)
+        return 0;
+
+    TTFlag flag = TT_EXACT;
+    if (node.best <= node.oldAlpha) {
+        flag = TT_ALPHA; // Not better than alpha
+        node.bestMove = Move{ {-1,-1}, {-1,-1}, nullptr, nullptr }; // All moves failed low, none is known to be best
+    }
+    else if (node.best >= node.beta) flag = TT_BETA;
+    // Cutoff
+
+    TT.store(node.key, node.best, node.depth, flag, node.bestMove, node.staticEval, node.ply);
+    return node.best;
+}
+
 /**
  * @brief Negamax search with alpha-beta pruning and transposition table (TT).
  *
  * High-level flow:
- * 1) Optional repetition detection (to avoid loops).
- * 2) Transposition Table probe to reuse cached scores/bounds.
+ * 1) Repetition detection (to avoid loops), fifty-move rule and insufficient
+ *    material, upcoming repetitions via the cuckoo table, mate distance pruning.
+ * 2) Transposition Table probe to reuse cached scores/bounds (mate scores stored relative to the node).
  * 3) Terminal / depth cutoff:
  *    - depth == 0 -> quiescence()
  *    - game over / no legal moves -> mate/stalemate scoring
- * 4) Generate legal moves, order them, recurse with sign flip:
+ *    - near the leaves (depth <= PRUNING_MAX_DEPTH, not in check): reverse futility
+ *      pruning at non-PV nodes, razoring into quiescence, futility pruning of quiet moves and
+ *      SEE pruning of quiet moves that hang a piece, with margins from params.h
+ * 4) Generate legal moves, reduce PV nodes without a TT move by one ply (IIR),
+ *    order them (orderMoves() with TT move/killers/history), recurse with sign flip:
  *      score = -negamax(child, depth-1, -beta, -alpha, -color)
- * 5) Update alpha and prune when alpha >= beta.
+ *    The first move gets the full window, later moves a null window (-alpha-1, -alpha)
+ *    and a full window re-search if they beat alpha (PVS), so only nodes on the
+ *    principal variation have beta - alpha > 1.
+ * 5) Update alpha and prune when alpha >= beta; quiet cutoff moves update
+ *    killers and history (see updateQuietStats()).
  * 6) Store result as TT_EXACT / TT_ALPHA / TT_BETA along with best move.
  *
  * @param board Board state (mutated via apply/undo during recursion).
@@ -677,64 +1212,86 @@ bool Engine::isRepetition(const Board& board) {
  * @param alpha Alpha bound (lower bound).
  * @param beta Beta bound (upper bound).
  * @param color Perspective sign (+1 = White perspective, -1 = Black perspective).
+ * @param ply Distance from the root (killer slots are per ply).
  * @return Best score from the perspective of @p color.
  *
  */
-int Engine::negamax(Board& board, int depth, int alpha, int beta, int color)
+int Engine::negamax(Board& board, int depth, int alpha, int beta, int color, int ply)
 {
-    if (isRepetition(board)) {
-        // 0 is equal position, slight minus for engine to avoid repetition
-        return -35;
-    }
+    Node node{ depth, alpha, beta, color, ply };
+    if (enterNode(board, node))
+        return node.result;
 
-    ++nodesVisited;
-    int ttScore;
-    Move ttMove;
-    // Read hash
-    unsigned long long key = board.zobristKey;
-    if (TT.probe(key, depth, alpha, beta, ttScore, ttMove)) {
-        return ttScore;
-        // Score found in TT, immediately return
+    for (auto& move : node.moves) {
+        Undo undo;
+        if (!enterChild(board, node, move, undo))
+            continue;
+        // Principal variation search: the first move gets the full window, later moves
+        // only have to prove they do not beat alpha and are searched again if they do
+        int score;
+        if (node.movesSearched == 1) {
+            score = -negamax(board, node.depth - 1, -node.beta, -node.alpha, -color, ply + 1);
+        }
+        else {
+            score = -negamax(board, node.depth - 1, -node.alpha - 1, -node.alpha, -color, ply + 1);
+            if (score > node.alpha && score < node.beta && !stopRequested())
+                score = -negamax(board, node.depth - 1, -node.beta, -node.alpha, -color, ply + 1);
+        }
+        if (leaveChild(board, node, move, undo, score))
+            break;
     }
+    return leaveNode(node);
+}
 
-    if (depth == 0 || gameOver(board))
-        return quiescence(board, alpha, beta, color);
+/**
+ * @brief Awaiter that parks a resumable node and returns control to the driver.
+ *
+ */
+struct NodeYield {
+    Engine& engine;
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> h) noexcept {
+        engine.suspended = h;
+        engine.nextYield = engine.nodesVisited + engine.yieldEvery;
+    }
+    void await_resume() const noexcept {}
+};
 
-    auto moves = legalMoves(board, to01(color));
+/**
+ * @brief Same node as negamax(), suspending every yieldEvery nodes.
+ *
+ * @details Shares the node phases with negamax(), so both search the same tree.
+ * Subtrees shallower than RESUMABLE_MIN_DEPTH run as plain negamax() calls: a
+ * coroutine frame per leaf would cost more than the finer slices are worth, and
+ * such a subtree only overshoots a slice by a few hundred nodes.
+ */
+SearchCoro Engine::negamaxResumable(Board& board, int depth, int alpha, int beta, int color, int ply)
+{
+    if (depth < RESUMABLE_MIN_DEPTH)
+        co_return negamax(board, depth, alpha, beta, color, ply);
 
-    if (moves.empty()) {
-        // No legal moves, check for checkmate or stalemate
-        if (isInCheck(board, to01(color))) return -100000 + depth; // CHECKMATE
-        return 0; // STALEMATE
-    }
+    if (yieldEvery > 0 && nodesVisited >= nextYield)
+        co_await NodeYield{ *this };
 
-    orderMoves(moves);
+    Node node{ depth, alpha, beta, color, ply };
+    if (enterNode(board, node))
+        co_return node.result;
 
-    int best = -INF;
-    Move bestMove;
-    // For TT storage
-    int oldAlpha = alpha;
-    for (auto& move : moves)
-    {
+    for (auto& move : node.moves) {
         Undo undo;
-        applyMove(board, move, undo);
-        int score = -negamax(board, depth - 1, -beta, -alpha, -color);
-        undoMove(board, move, undo);
-        if (score > best)
-            best = score;
-        if (score > alpha)
-            alpha = score;
-        if (alpha >= beta)
+        if (!enterChild(board, node, move, undo))
+            continue;
+        int score;
+        if (node.movesSearched == 1) {
+            score = -co_await negamaxResumable(board, node.depth - 1, -node.beta, -node.alpha, -color, ply + 1);
+        }
+        else {
+            score = -co_await negamaxResumable(board, node.depth - 1, -node.alpha - 1, -node.alpha, -color, ply + 1);
+            if (score > node.alpha && score < node.beta && !stopRequested())
+                score = -co_await negamaxResumable(board, node.depth - 1, -node.beta, -node.alpha, -color, ply + 1);
+        }
+        if (leaveChild(board, node, move, undo, score))
             break;
-        // beta cutoff
     }
-
-    TTFlag flag = TT_EXACT;
-    if (best <= oldAlpha) flag = TT_ALPHA; // Not better than alpha
-    else if (best >= beta) flag = TT_BETA;
-    // Cutoff
-
-    TT.store(key, best, depth, flag, bestMove);
-
-    return best;
-}
\ No newline at end of file
+    co_return leaveNode(node);
+}
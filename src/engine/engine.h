@@ -8,9 +8,16 @@
  */
 #pragma once
 
+#include <atomic>
 #include <vector>
 #include "../Board.h"
 #include "moves.h"
+#include "tables/history.h"
+#include "tables/repetition.h"
+#include "bitboard.h"
+#include "timeman.h"
+#include "progress.h"
+#include "coro.h"
 
 class Engine {
 public:
@@ -25,6 +32,17 @@ public:
 		Piece* pieceMoved;
 		Piece* pieceCaptured;
 		char promotion;
+		int halfmoveClock;                // board.halfmoveClock before the move
+		unsigned long long materialKey;   // board.materialKey before the move
+	};
+	/**
+	 * @brief Per-ply search stack entry (the move made at that ply).
+	 *
+	 */
+	struct StackEntry
+	{
+		int pieceIdx = -1; // getPieceIndex() of the moved piece, -1 if no move
+		int toSq = 0;      // to-square of the move (row * 8 + col)
 	};
 	// ================================
 	// Small helpers used across engine
@@ -72,6 +90,88 @@ public:
 	 */
 	long get_nodes_visited();
 
+	/**
+	 * @brief Nodes visited by this engine instance.
+	 *
+	 */
+	long nodesVisited = 0;
+
+	/**
+	 * @brief Shared stop flag set by the search driver (nullptr = never stopped).
+	 *
+	 */
+	std::atomic<bool>* stopFlag = nullptr;
+
+	/**
+	 * @brief Check whether the search driver asked this engine to stop.
+	 * @return true if the stop flag is set; the current search result must be discarded
+	 */
+	bool stopRequested() const;
+
+	/**
+	 * @brief Clock of the search, polled every TIME_CHECK_NODES nodes (nullptr = no time limit).
+	 *
+	 */
+	const TimeManager* timer = nullptr;
+
+	/**
+	 * @brief Node count shared by the threads of a search, flushed every TIME_CHECK_NODES nodes (nullptr = none).
+	 *
+	 */
+	std::atomic<long>* nodeCounter = nullptr;
+
+	/**
+	 * @brief Live progress of the search, updated by the main search thread only (nullptr = none).
+	 *
+	 */
+	SearchProgress* progress = nullptr;
+
+	/**
+	 * @brief Every TIME_CHECK_NODES nodes: flush the shared node count, update the
+	 * live progress, set the stop flag once the hard time limit has passed.
+	 */
+	void pollTime();
+
+	/**
+	 * @brief Prefetch the child's TT cluster in applyMove() (runtime toggle for benchmarking).
+	 *
+	 */
+	bool prefetchTT = true;
+
+	// ================================
+	// Move ordering state
+	// ================================
+
+	/**
+	 * @brief Killer moves and butterfly history of this engine instance.
+	 *
+	 */
+	HistoryTables history;
+
+	/**
+	 * @brief Search stack, stack[ply] describes the move made at ply (read by ply + 1 and ply + 2).
+	 *
+	 */
+	StackEntry stack[MAX_PLY + 1];
+
+	/**
+	 * @brief Keys of the game history and the current search path (repetition detection).
+	 *
+	 */
+	RepetitionStack repetitions;
+
+	/**
+	 * @brief Record the move made at @p ply in the search stack.
+	 * @param ply distance from the root
+	 * @param move move about to be searched
+	 */
+	void recordMove(int ply, const Move& move);
+
+	/**
+	 * @brief Prepare ordering tables for a new search (ages history, clears killers).
+	 */
+	void newSearch();
+
 	// ================================
 	// Core engine API
 	// ================================
@@ -90,9 +190,10 @@ public:
 	 * @param alpha alpha bound
 	 * @param beta beta bound
 	 * @param color Perspective sign (+1 white, -1 black)
+	 * @param ply distance from the root (mate score conversion of TT entries)
 	 * @return quiescence score
 	 */
-	int quiescence(Board& board, int alpha, int beta, int color);
+	int quiescence(Board& board, int alpha, int beta, int color, int ply = 0);
 
 	/**
 	 * @brief Negamax search with alpha-beta pruning and transposition table.
@@ -101,9 +202,104 @@ public:
 	 * @param alpha alpha bound
 	 * @param beta beta bound
 	 * @param color Perspective sign (+1 white, -1 black)
+	 * @param ply distance from the root (indexes killer slots)
 	 * @return best score
 	 */
-	int negamax(Board& board, int depth, int alpha, int beta, int color);
+	int negamax(Board& board, int depth, int alpha, int beta, int color, int ply = 0);
+
+	/**
+	 * @brief State of one negamax node, shared by the node phases below.
+	 *
+	 */
+	struct Node
+	{
+		int depth = 0;                  // Remaining depth (reduced by IIR)
+		int alpha = 0;
+		int beta = 0;
+		int color = 1;                  // Perspective sign (+1 white, -1 black)
+		int ply = 0;
+		int result = 0;                 // Score of a node resolved by enterNode()
+		unsigned long long key = 0;
+		int oldAlpha = 0;               // Alpha before the move loop (TT bound)
+		int staticEval = 0;             // TT_EVAL_NONE if not computed
+		bool inCheck = false;
+		bool pvNode = false;            // Full window (beta - alpha > 1), on the principal variation
+		bool futile = false;            // Quiet moves cannot raise alpha
+		bool seePruning = false;
+		bool stopped = false;           // Move loop interrupted by a stop request
+		BoardBitboards bb{};            // Snapshot for SEE pruning
+		std::vector<Move> moves{};
+		int best = 0;
+		Move bestMove{ {-1,-1}, {-1,-1}, nullptr, nullptr };
+		std::vector<Move> quietsTried{};
+		int movesSearched = 0;
+	};
+
+	/**
+	 * @brief Node phase before the move loop (draws, TT probe, pruning, move generation and ordering).
+	 * @param board Board state
+	 * @param node Node state
+	 * @return true if the node is resolved, score in node.result
+	 */
+	bool enterNode(Board& board, Node& node);
+
+	/**
+	 * @brief Node phase before a child: prune the move or make it.
+	 * @param board Board state
+	 * @param node Node state
+	 * @param move Move to try
+	 * @param undo Undo data of the move
+	 * @return true if the move was made and its child must be searched
+	 */
+	bool enterChild(Board& board, Node& node, const Move& move, Undo& undo);
+
+	/**
+	 * @brief Node phase after a child: take the move back and update the bounds.
+	 * @param board Board state
+	 * @param node Node state
+	 * @param move Move that was searched
+	 * @param undo Undo data of the move
+	 * @param score Child score from the node's perspective
+	 * @return true if the move loop ends (cutoff or stop)
+	 */
+	bool leaveChild(Board& board, Node& node, const Move& move, const Undo& undo, int score);
+
+	/**
+	 * @brief Node phase after the move loop: store the result in the TT.
+	 * @param node Node state
+	 * @return best score, 0 if stopped
+	 */
+	int leaveNode(Node& node);
+
+	/**
+	 * @brief negamax() as a coroutine that suspends every yieldEvery nodes (see ResumableSearch).
+	 * @param board Board state (mutated via apply/undo, mid-search while suspended)
+	 * @param depth depth in plies
+	 * @param alpha alpha bound
+	 * @param beta beta bound
+	 * @param color Perspective sign (+1 white, -1 black)
+	 * @param ply distance from the root
+	 * @return task producing the same score as negamax()
+	 */
+	SearchCoro negamaxResumable(Board& board, int depth, int alpha, int beta, int color, int ply);
+
+	/**
+	 * @brief Nodes between two suspensions of negamaxResumable() (0 = never suspend).
+	 *
+	 */
+	long yieldEvery = 0;
+
+	/**
+	 * @brief nodesVisited at which negamaxResumable() suspends next.
+	 *
+	 */
+	long nextYield = 0;
+
+	/**
+	 * @brief Node suspended by negamaxResumable(), resumed by the driver (empty = none).
+	 *
+	 */
+	std::coroutine_handle<> suspended;
 
 	/**
 	 * @brief Check if the given side is in check.
@@ -123,11 +319,18 @@ public:
 	bool isSquareAttacked(Board& board, Position pos, int attackerColor);
 
 	/**
-	 * @brief Check repetition based on board.positionHistory and zobristKey.
-	 * @param board Board state
-	 * @return true if current position repeated
+	 * @brief Check whether the current position repeats one from the game or the search path.
+	 * @return true if the top of the repetition stack appeared before with the same side to move
 	 */
-	bool isRepetition(const Board& board);
+	bool isRepetition() const;
+
+	/**
+	 * @brief Check whether the side to move can repeat an earlier position with one reversible move.
+	 * @param board Board state (current position, top of the repetition stack)
+	 * @param ply distance from the root
+	 * @return true if a cuckoo table move with a clear path leads back to an earlier position
+	 */
+	bool upcomingRepetition(const Board& board, int ply) const;
 
 	// ================================
 	// Move helpers used by UI/engine
@@ -148,6 +351,38 @@ public:
 	 *
 	 */
 	void orderMoves(std::vector<Move>& moves);
+
+	/**
+	 * @brief Order moves: TT move, then captures (good / bad by SEE), promotions, killers and history.
+	 * @param board Board state (SEE of captures)
+	 * @param moves move list to sort
+	 * @param ply distance from the root
+	 * @param color01 side to move, 0=white, 1=black
+	 * @param ttMove best move stored in the TT, tried first (from.row == -1 if none)
+	 *
+	 */
+	void orderMoves(Board& board, std::vector<Move>& moves, int ply, int color01,
+		const Move& ttMove = Move{ {-1,-1}, {-1,-1}, nullptr, nullptr });
+
+	/**
+	 * @brief Score a move for ordering (good captures > promotions > killers > countermove > history > bad captures).
+	 * @param bb bitboard snapshot of the position (SEE of captures)
+	 * @param move move to score
+	 * @param ply distance from the root
+	 * @param color01 side to move, 0=white, 1=black
+	 * @return ordering score, higher is tried first
+	 */
+	int scoreMove(const BoardBitboards& bb, const Move& move, int ply, int color01);
+
+	/**
+	 * @brief Reward a quiet cutoff move (killer, countermove, history, continuation history) and penalize quiets tried before it.
+	 * @param move cutoff move
+	 * @param quietsTried quiet moves searched before the cutoff move
+	 * @param depth remaining depth of the node
+	 * @param ply distance from the root
+	 * @param color01 side to move, 0=white, 1=black
+	 */
+	void updateQuietStats(const Move& move, const std::vector<Move>& quietsTried, int depth, int ply, int color01);
 	/**
  * @brief Reverts a previously applied move (make/undo search loop).
  *
@@ -174,13 +409,15 @@ public:
  *   - XOR out captured piece from to-square (if any),
  *   - XOR in moved/promoted piece on to-square,
  *   - XOR side-to-move key.
+ * - Updates halfmoveClock (reset by captures and pawn moves) and the material signature.
  * - Handles promotion by changing the moved piece symbol to @p move.promotion.
  *
  * @param board Board state to mutate.
  * @param move Move to apply.
  * @param undo Output snapshot used later by undoMove().
+ * @param prefetch Prefetch the child's TT cluster (false for legality checks, no probe follows).
  *
  * @note This function assumes Piece pointers live outside and are not owned here.
  */
-	void applyMove(Board& board, const Move& move, Undo& undo);
+	void applyMove(Board& board, const Move& move, Undo& undo, bool prefetch = true);
 };
\ No newline at end of file
@@ -0,0 +1,135 @@
+/**
+ * @file params.h
+ * @brief File declaration for search tuning parameters (pruning margins, SEE thresholds).
+ * @version 0.1
+ * @date 2026-01-12
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+#pragma once
+
+/**
+ * @brief Highest remaining depth where leaf pruning (RFP, futility, razoring) applies.
+ *
+ */
+static const int PRUNING_MAX_DEPTH = 3;
+
+// Margins are indexed by remaining depth, index 0 is unused (quiescence).
+
+/**
+ * @brief Reverse futility (static null move) margins.
+ *
+ * @details If static eval - margin[depth] >= beta, the node is assumed to fail high.
+ */
+inline static const int reverseFutilityMargin[PRUNING_MAX_DEPTH + 1] = { 0, 120, 240, 360 };
+
+/**
+ * @brief Futility margins for quiet moves.
+ *
+ * @details If static eval + margin[depth] <= alpha, quiet moves that do not give
+ * check are skipped (at least one move is always searched).
+ */
+inline static const int futilityMargin[PRUNING_MAX_DEPTH + 1] = { 0, 150, 300, 450 };
+
+/**
+ * @brief Razoring margins.
+ *
+ * @details If static eval + margin[depth] < alpha, the node drops into quiescence
+ * and is pruned if quiescence confirms the fail low.
+ */
+inline static const int razorMargin[PRUNING_MAX_DEPTH + 1] = { 0, 300, 500, 700 };
+
+/**
+ * @brief SEE thresholds for pruning quiet moves near the leaves.
+ *
+ * @details Quiet moves whose SEE is below threshold[depth] (the moved piece is
+ * lost to an exchange) are skipped once one move was searched.
+ */
+inline static const int seeQuietThreshold[PRUNING_MAX_DEPTH + 1] = { 0, -50, -100, -200 };
+
+/**
+ * @brief Minimum depth for internal iterative reduction.
+ *
+ * @details PV nodes (full window, see the PVS in Engine::negamax()) at this depth
+ * or deeper without a TT move are searched one ply shallower.
+ */
+inline static const int IIR_MIN_DEPTH = 4;
+
+/**
+ * @brief Delta pruning margin in quiescence.
+ *
+ * @details A capture is skipped if stand pat + victim value + margin <= alpha
+ * (promotions are always searched).
+ */
+inline static const int DELTA_MARGIN = 200;
+
+/**
+ * @brief Score of a repeated position for the side to move.
+ *
+ * @details Slightly below 0, so the side that has to face the repetition avoids it.
+ * The side that can force a repetition is guaranteed the negated value.
+ */
+inline static const int REPETITION_SCORE = -35;
+
+/**
+ * @brief Nodes between two reads of the clock inside the search (power of two).
+ *
+ * @details Keeps the hard time limit overrun to well below a millisecond.
+ */
+inline static const int TIME_CHECK_NODES = 1024;
+
+/**
+ * @brief Moves the game clock is split over at the start of the game.
+ *
+ * @details One fewer per two moves played, down to TM_MIN_MOVES_TO_GO.
+ */
+inline static const int TM_MOVES_TO_GO = 40;
+
+/**
+ * @brief Fewest moves the game clock is split over.
+ *
+ */
+inline static const int TM_MIN_MOVES_TO_GO = 20;
+
+/**
+ * @brief Hard limit as a multiple of the optimum time per move.
+ *
+ */
+inline static const int TM_HARD_FACTOR = 4;
+
+/**
+ * @brief Largest share of the remaining clock one move may use, in percent.
+ *
+ */
+inline static const int TM_MAX_CLOCK_PERCENT = 20;
+
+/**
+ * @brief Time kept back from the clock for move transfer and GUI latency, in ms.
+ *
+ */
+inline static const int TM_OVERHEAD_MS = 50;
+
+/**
+ * @brief Score drop (centipawns) between iterations that doubles the soft limit.
+ *
+ */
+inline static const int TM_SCORE_DROP = 100;
+
+/**
+ * @brief Shortest interval between two live progress updates of the node count, in ms.
+ *
+ */
+inline static const int PROGRESS_INTERVAL_MS = 50;
+
+/**
+ * @brief Nodes searched per slice by the resumable (cooperative) search.
+ *
+ */
+inline static const int RESUMABLE_SLICE_NODES = 4096;
+
+/**
+ * @brief Shallowest remaining depth searched as a coroutine by the resumable search, shallower subtrees run plain.
+ *
+ */
+inline static const int RESUMABLE_MIN_DEPTH = 2;
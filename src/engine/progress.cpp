@@ -0,0 +1,111 @@
+/**
+ * @file progress.cpp
+ * @brief File implementation for the live search progress snapshot.
+ * @version 0.1
+ * @date 2026-01-12
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "progress.h"
+#include "params.h"
+#include "tables/TT.h"
+#include <chrono>
+
+/// Current steady_clock time in nanoseconds.
+static long long nowNs()
+{
+    return (long long)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void SearchProgress::begin(int color)
+{
+    current = SearchInfo();
+    current.color = color;
+    startNs = lastPublishNs = nowNs();
+    publish();
+}
+
+void SearchProgress::setNodes(long long nodes)
+{
+    current.nodes = nodes;
+    long long now = nowNs();
+    if (now - lastPublishNs < PROGRESS_INTERVAL_MS * 1000000LL) return;
+    lastPublishNs = now;
+    publish();
+}
+
+void SearchProgress::setIteration(int depth, int score, const std::vector<Move>& pv)
+{
+    current.depth = depth;
+    current.score = score;
+    current.pvLength = 0;
+    for (const Move& m : pv) {
+        if (current.pvLength == PROGRESS_MAX_PV) break;
+        current.pv[current.pvLength++] = (unsigned short)((m.from.row * 8 + m.from.col) | ((m.to.row * 8 + m.to.col) << 6));
+    }
+    lastPublishNs = nowNs();
+    publish();
+}
+
+void SearchProgress::finish(long long nodes)
+{
+    current.nodes = nodes;
+    lastPublishNs = nowNs();
+    publish();
+}
+
+/**
+ * @brief Copy the writer side snapshot into the back slot and make it the front one.
+ *
+ * @details Also refreshes nps and hashfull, which only readers need.
+ */
+void SearchProgress::publish()
+{
+    long long elapsedNs = lastPublishNs - startNs;
+    current.nps = elapsedNs > 0 ? current.nodes * 1000000000LL / elapsedNs : 0;
+    current.hashfull = TT.hashfull();
+
+    Slot& s = slots[1 - front.load(std::memory_order_relaxed)];
+    unsigned seq = s.seq.load(std::memory_order_relaxed);
+    s.seq.store(seq + 1, std::memory_order_relaxed); // Odd: being written
+    std::atomic_thread_fence(std::memory_order_release);
+
+    s.depth.store(current.depth, std::memory_order_relaxed);
+    s.score.store(current.score, std::memory_order_relaxed);
+    s.color.store(current.color, std::memory_order_relaxed);
+    s.hashfull.store(current.hashfull, std::memory_order_relaxed);
+    s.nodes.store(current.nodes, std::memory_order_relaxed);
+    s.nps.store(current.nps, std::memory_order_relaxed);
+    s.pvLength.store(current.pvLength, std::memory_order_relaxed);
+    for (int i = 0; i < current.pvLength; ++i)
+        s.pv[i].store(current.pv[i], std::memory_order_relaxed);
+
+    s.seq.store(seq + 2, std::memory_order_release);
+    front.store(1 - front.load(std::memory_order_relaxed), std::memory_order_release);
+}
+
+SearchInfo SearchProgress::read() const
+{
+    SearchInfo info;
+    for (int attempt = 0; attempt < 4; ++attempt) { // Bounded: never blocks the caller
+        const Slot& s = slots[front.load(std::memory_order_acquire)];
+        unsigned before = s.seq.load(std::memory_order_acquire);
+
+        info.depth = s.depth.load(std::memory_order_relaxed);
+        info.score = s.score.load(std::memory_order_relaxed);
+        info.color = s.color.load(std::memory_order_relaxed);
+        info.hashfull = s.hashfull.load(std::memory_order_relaxed);
+        info.nodes = s.nodes.load(std::memory_order_relaxed);
+        info.nps = s.nps.load(std::memory_order_relaxed);
+        info.pvLength = s.pvLength.load(std::memory_order_relaxed);
+        if (info.pvLength > PROGRESS_MAX_PV) info.pvLength = PROGRESS_MAX_PV;
+        for (int i = 0; i < info.pvLength; ++i)
+            info.pv[i] = s.pv[i].load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (!(before & 1) && s.seq.load(std::memory_order_relaxed) == before)
+            break;
+    }
+    return info;
+}
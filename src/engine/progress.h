@@ -0,0 +1,99 @@
+/**
+ * @file progress.h
+ * @brief File declaration for the live search progress snapshot (lock-free, double-buffered).
+ * @version 0.1
+ * @date 2026-01-12
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+#include <atomic>
+#include <vector>
+#include "moves.h"
+
+/**
+ * @brief Longest principal variation kept in a progress snapshot.
+ *
+ */
+const int PROGRESS_MAX_PV = 16;
+
+/**
+ * @brief Progress of the running search, as seen by a reader.
+ *
+ */
+struct SearchInfo {
+    int depth = 0;             // Deepest completed iteration, 0 = none yet
+    int score = 0;             // Score of that iteration, side to move perspective
+    int color = 0;             // Side to move, 0 = White, 1 = Black
+    long long nodes = 0;       // Nodes of all threads so far
+    long long nps = 0;         // Nodes per second since the search started
+    int hashfull = 0;          // TT entries of this search, per mille
+    int pvLength = 0;
+    unsigned short pv[PROGRESS_MAX_PV] = {}; // from | to << 6, squares are row * 8 + col
+};
+
+/**
+ * @brief Search progress published by the main search thread, read by any thread without blocking.
+ *
+ * @details Two slots, each guarded by a sequence counter (odd while being
+ * written). The writer fills the slot readers are not pointed at, then flips
+ * the front index, so a reader only retries if the writer laps it twice during
+ * one read. Every field is a relaxed atomic, a torn read never is a data race.
+ * There must be a single writer (the thread running SearchPool::run()).
+ */
+class SearchProgress {
+public:
+    /**
+     * @brief Start a new search: clear the snapshot and the nps clock (writer).
+     *
+     * @param color Side to move, 0 = White, 1 = Black.
+     */
+    void begin(int color);
+
+    /**
+     * @brief Update the node count, published at most every few milliseconds (writer).
+     *
+     * @param nodes Nodes of all threads so far.
+     */
+    void setNodes(long long nodes);
+
+    /**
+     * @brief Publish a completed iteration (writer).
+     *
+     * @param depth Depth of the iteration.
+     * @param score Score from the side to move perspective.
+     * @param pv Principal variation, truncated to PROGRESS_MAX_PV moves.
+     */
+    void setIteration(int depth, int score, const std::vector<Move>& pv);
+
+    /**
+     * @brief Publish the exact node count of a finished search, bypassing the rate limit (writer).
+     *
+     * @param nodes Nodes of all threads.
+     */
+    void finish(long long nodes);
+
+    /**
+     * @brief Latest published snapshot (any thread, lock-free).
+     *
+     * @return Copy of the snapshot.
+     */
+    SearchInfo read() const;
+
+private:
+    struct Slot {
+        std::atomic<unsigned> seq{ 0 };
+        std::atomic<int> depth{ 0 }, score{ 0 }, color{ 0 }, hashfull{ 0 }, pvLength{ 0 };
+        std::atomic<long long> nodes{ 0 }, nps{ 0 };
+        std::atomic<unsigned short> pv[PROGRESS_MAX_PV];
+    };
+
+    void publish();
+
+    Slot slots[2];
+    std::atomic<int> front{ 0 };
+    SearchInfo current;        // Writer side copy
+    long long startNs = 0;     // Writer only
+    long long lastPublishNs = 0;
+};
@@ -0,0 +1,94 @@
+/**
+ * @file resumable.cpp
+ * @brief File implementation for the resumable search.
+ * @version 0.1
+ * @date 2026-01-12
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "resumable.h"
+#include "tables/TT.h"
+#include <utility>
+
+ResumableSearch::ResumableSearch(long sliceNodes)
+{
+    engine.yieldEvery = sliceNodes;
+    engine.stopFlag = &stopFlag;
+    engine.nodeCounter = &nodeCount; // Clock and progress are attached by iterativeDeepening()
+}
+
+void ResumableSearch::start(const Board& position, int color01, const SearchLimits& limits)
+{
+    task = SearchCoro(); // Drops an unfinished search
+    engine.suspended = {};
+    board = position;
+
+    stopFlag.store(false, std::memory_order_relaxed);
+    nodeCount.store(0, std::memory_order_relaxed);
+    if (limits.clockMs > 0)
+        timer.startFromClock(limits.clockMs, limits.incrementMs, limits.moveNumber);
+    else
+        timer.start(limits.timeLimitMs, limits.hardLimitMs);
+    TT.newSearch();
+    liveProgress.begin(color01);
+
+    out = SearchResult();
+    nodesBefore = engine.nodesVisited;
+    sliceCount = 0;
+    engine.nextYield = engine.nodesVisited + engine.yieldEvery;
+    task = deepen(color01, limits);
+}
+
+bool ResumableSearch::step()
+{
+    if (finished()) return true;
+    ++sliceCount;
+    // Resume the node that yielded, or start the driver on the first step
+    std::coroutine_handle<> next = engine.suspended ? std::exchange(engine.suspended, {}) : task.handle;
+    next.resume();
+    out.nodes = engine.nodesVisited - nodesBefore;
+    return finished();
+}
+
+bool ResumableSearch::finished() const
+{
+    return !task.handle || task.handle.done();
+}
+
+void ResumableSearch::stop()
+{
+    stopFlag.store(true, std::memory_order_relaxed);
+}
+
+SearchResult ResumableSearch::result() const
+{
+    return out;
+}
+
+/**
+ * @brief Iterative deepening of the resumable search.
+ *
+ * @details Runs the same iterativeDeepening() as the main thread of SearchPool,
+ * the engine yields so the root children are searched by
+ * Engine::negamaxResumable(). Copies the result to out once it completes.
+ * @param color01 Side to move.
+ * @param limits Depth limit.
+ * @return Task, the result is written to out.
+ */
+SearchCoro ResumableSearch::deepen(int color01, SearchLimits limits)
+{
+    DeepeningResult result;
+    co_await iterativeDeepening(engine, board, color01, limits, 1, &timer, &liveProgress, result);
+
+    // Pointers refer to the search's board, hand over squares only
+    for (auto& line : result.lines) {
+        line.move.pieceMoved = line.move.pieceCaptured = nullptr;
+        out.lines.push_back(line);
+    }
+    out.bestMove = result.bestMove; // Stopped before depth 1: any legal move
+    out.bestMove.pieceMoved = out.bestMove.pieceCaptured = nullptr;
+    out.score = result.score;
+    out.depth = result.depth;
+    co_return out.score;
+}
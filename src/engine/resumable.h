@@ -0,0 +1,101 @@
+/**
+ * @file resumable.h
+ * @brief File declaration for the resumable search (coroutine driver run in slices on the caller's thread).
+ * @version 0.1
+ * @date 2026-01-12
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+#include <atomic>
+#include "../Board.h"
+#include "engine.h"
+#include "params.h"
+#include "search.h"
+
+/**
+ * @brief Single-threaded search that runs in slices of about N nodes.
+ *
+ * Iterative deepening and negamax run as coroutines (see
+ * Engine::negamaxResumable()); step() resumes them until the next slice is
+ * used up. The caller (e.g. the GUI loop) interleaves steps with its own work
+ * on the same thread, without a worker thread or a board handed over to one.
+ * The search works on its own board copy, which is mid-search between steps.
+ */
+class ResumableSearch {
+public:
+    /**
+     * @brief Construct the search.
+     *
+     * @param sliceNodes Nodes per step(), 0 = run to the end in one step.
+     */
+    explicit ResumableSearch(long sliceNodes = RESUMABLE_SLICE_NODES);
+
+    ResumableSearch(const ResumableSearch&) = delete;
+    ResumableSearch& operator=(const ResumableSearch&) = delete;
+
+    /**
+     * @brief Set up a search, nothing is searched until step().
+     *
+     * @param board Position to search (copied).
+     * @param color01 Side to move, 0 = White, 1 = Black.
+     * @param limits Depth and time limits (the clock starts now).
+     */
+    void start(const Board& board, int color01, const SearchLimits& limits);
+
+    /**
+     * @brief Search one slice.
+     *
+     * @return True once the search has finished (also if none was started).
+     */
+    bool step();
+
+    /**
+     * @brief Check whether the search has finished.
+     *
+     * @return True if result() is final.
+     */
+    bool finished() const;
+
+    /**
+     * @brief Make the next step() finish the search with the deepest completed iteration.
+     *
+     */
+    void stop();
+
+    /**
+     * @brief Result of the search.
+     *
+     * @return Best move of the deepest completed iteration, squares only (from.row == -1 if none).
+     */
+    SearchResult result() const;
+
+    /**
+     * @brief Number of step() calls of the current search.
+     *
+     * @return Slices run so far.
+     */
+    long slices() const { return sliceCount; }
+
+    /**
+     * @brief Live progress of the search.
+     *
+     * @return Progress published at each completed iteration.
+     */
+    const SearchProgress& progress() const { return liveProgress; }
+
+private:
+    SearchCoro deepen(int color01, SearchLimits limits);
+
+    Engine engine;
+    Board board;
+    std::atomic<bool> stopFlag{ false };
+    std::atomic<long> nodeCount{ 0 };
+    TimeManager timer;
+    SearchProgress liveProgress;
+    SearchCoro task;              // Iterative deepening coroutine, empty if none started
+    SearchResult out;
+    long nodesBefore = 0;
+    long sliceCount = 0;
+};
@@ -0,0 +1,392 @@
+/**
+ * @file search.cpp
+ * @brief File implementation for the search driver (iterative deepening, Lazy SMP thread pool).
+ * @version 0.1
+ * @date 2026-01-12
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "search.h"
+#include "val.h"
+#include "tables/TT.h"
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+/**
+ * @brief Put the root moves of the previous iteration's lines in front, in rank order.
+ *
+ * @param moves Root moves.
+ * @param lines Lines of the previous iteration (empty before the first one).
+ */
+static void orderRootMoves(std::vector<Move>& moves, const std::vector<RootLine>& lines)
+{
+    for (size_t r = 0; r < lines.size() && r < moves.size(); ++r)
+        for (size_t i = r; i < moves.size(); ++i)
+            if (sameMove(moves[i], lines[r].move)) {
+                std::swap(moves[r], moves[i]);
+                break;
+            }
+}
+
+/**
+ * @brief Check whether a root move already is the move of one of @p lines.
+ *
+ * @param lines Lines found so far in this iteration.
+ * @param move Root move.
+ * @return True if the move is taken by a line.
+ */
+static bool isLineMove(const std::vector<RootLine>& lines, const Move& move)
+{
+    for (const auto& line : lines)
+        if (sameMove(line.move, move)) return true;
+    return false;
+}
+
+/**
+ * @brief Sort the lines of an iteration by score, best first (stable).
+ *
+ * @param lines Lines of the iteration.
+ */
+static void rankLines(std::vector<RootLine>& lines)
+{
+    // Scores of later lines are exact too, an unstable search can rank them above earlier ones
+    std::stable_sort(lines.begin(), lines.end(), [](const RootLine& a, const RootLine& b) { return a.score > b.score; });
+}
+
+/**
+ * @brief Principal variation of a completed iteration, followed through the TT.
+ *
+ * @details Stops at a missing or illegal TT move and at a repeated position.
+ * @p board is restored before returning.
+ * @param engine Engine owning @p board.
+ * @param board Board at the root.
+ * @param color01 Side to move at the root.
+ * @param first Best root move of the iteration.
+ * @return Moves of the variation (pointers into @p board, valid until it changes).
+ */
+static std::vector<Move> extractPV(Engine& engine, Board& board, int color01, const Move& first)
+{
+    std::vector<Move> pv;
+    std::vector<Engine::Undo> undos;
+    std::vector<unsigned long long> seen{ board.zobristKey };
+    pv.reserve(PROGRESS_MAX_PV);
+    undos.reserve(PROGRESS_MAX_PV);
+
+    Move move = first;
+    int color = color01;
+    while (move.pieceMoved && (int)pv.size() < PROGRESS_MAX_PV) {
+        pv.push_back(move);
+        undos.emplace_back();
+        engine.applyMove(board, move, undos.back());
+        if (std::find(seen.begin(), seen.end(), board.zobristKey) != seen.end()) break;
+        seen.push_back(board.zobristKey);
+        color ^= 1;
+
+        int score = 0;
+        Move ttMove{ {-1,-1}, {-1,-1}, nullptr, nullptr };
+        TT.probe(board.zobristKey, 0, -INF, INF, score, ttMove);
+        move = Move{ {-1,-1}, {-1,-1}, nullptr, nullptr };
+        if (ttMove.from.row < 0) break;
+        for (const Move& m : engine.legalMoves(board, color))
+            if (sameMove(m, ttMove)) { move = m; break; }
+    }
+    for (int i = (int)pv.size() - 1; i >= 0; --i)
+        engine.undoMove(board, pv[i], undos[i]);
+    return pv;
+}
+
+SearchCoro iterativeDeepening(Engine& engine, Board& board, int color01, SearchLimits limits,
+    int startDepth, TimeManager* timer, SearchProgress* progress, DeepeningResult& result)
+{
+    int sign = color01 == 0 ? 1 : -1;
+
+    auto moves = engine.legalMoves(board, color01);
+    if (moves.empty()) co_return 0;
+
+    engine.orderMoves(moves);
+    engine.newSearch(); // Age history, clear killers from previous move
+    engine.repetitions.reset(board.positionHistory, board.zobristKey, board.halfmoveClock);
+    result.bestMove = moves[0];
+
+    engine.timer = timer;
+    engine.progress = progress;
+    auto timeUp = [&]() {
+        return engine.stopRequested() || (timer && timer->hardExpired());
+    };
+
+    for (int currentDepth = startDepth; currentDepth <= limits.maxDepth; ++currentDepth) {
+        // The next iteration takes longer than all previous ones, do not start it late
+        if (currentDepth > startDepth && timer && timer->softExpired())
+            break;
+
+        // Primitive sorting: lines of the previous depth first, best move in front
+        orderRootMoves(moves, result.lines);
+
+        // MultiPV: each line searches the root moves not taken by a better line, with a full window
+        int lineCount = std::min(std::max(limits.multiPV, 1), (int)moves.size());
+        std::vector<RootLine> lines;
+        bool aborted = false;
+        for (int pvIdx = 0; pvIdx < lineCount && !aborted; ++pvIdx) {
+            int alpha = -INF;
+            int beta = INF;
+            RootLine line{ moves[0], -1000000 };
+
+            for (auto& move : moves) {
+                if (isLineMove(lines, move))
+                    continue;
+                if (timeUp()) {
+                    aborted = true;
+                    break;
+                }
+                Engine::Undo undo;
+
+                engine.recordMove(0, move);
+                engine.applyMove(board, move, undo);
+                engine.repetitions.push(board.zobristKey, board.halfmoveClock);
+                int score = engine.yieldEvery > 0
+                    ? -co_await engine.negamaxResumable(board, currentDepth - 1, -beta, -alpha, -sign, 1)
+                    : -engine.negamax(board, currentDepth - 1, -beta, -alpha, -sign, 1);
+                engine.repetitions.pop();
+                engine.undoMove(board, move, undo);
+
+                if (engine.stopRequested()) { // Score of an interrupted subtree is meaningless
+                    aborted = true;
+                    break;
+                }
+                if (score > line.score) {
+                    line.score = score;
+                    line.move = move;
+                }
+                if (score > alpha) alpha = score;
+            }
+            if (!aborted) lines.push_back(line);
+        }
+        if (aborted) break;
+
+        rankLines(lines);
+        const Move& bestMoveThisDepth = lines[0].move;
+        int bestScoreThisDepth = lines[0].score;
+
+        if (timer && result.depth > 0)
+            timer->onIteration(!sameMove(bestMoveThisDepth, result.bestMove), result.score - bestScoreThisDepth);
+
+        result.bestMove = bestMoveThisDepth;
+        result.score = bestScoreThisDepth;
+        result.depth = currentDepth;
+        result.lines = lines;
+        if (progress)
+            progress->setIteration(currentDepth, bestScoreThisDepth, extractPV(engine, board, color01, bestMoveThisDepth));
+
+        // Mate found within this iteration's horizon, deeper search cannot find a shorter one
+        if (bestScoreThisDepth > MATE_BOUND && MATE_SCORE - bestScoreThisDepth <= currentDepth) break;
+    }
+    co_return result.score;
+}
+
+/**
+ * @brief Run iterativeDeepening() to the end on the calling thread.
+ *
+ * @details The engine does not yield, so the coroutine completes on its first resume.
+ * @return Deepest completed iteration.
+ */
+static DeepeningResult searchThread(Engine& engine, Board& board, int color01, const SearchLimits& limits,
+    int startDepth, TimeManager* timer, SearchProgress* progress)
+{
+    DeepeningResult result;
+    SearchCoro task = iterativeDeepening(engine, board, color01, limits, startDepth, timer, progress, result);
+    task.handle.resume();
+    return result;
+}
+
+/**
+ * @brief Map a move found on a board copy to the pieces of @p board.
+ *
+ * @param board Board the move will be played on.
+ * @param move Move with pointers into another board copy.
+ * @return Same move with pointers into @p board.
+ */
+static Move remapMove(const Board& board, const Move& move)
+{
+    if (!move.pieceMoved) return move;
+    Move m = move;
+    m.pieceMoved = board.squares[move.from.row][move.from.col];
+    m.pieceCaptured = board.squares[move.to.row][move.to.col];
+    return m;
+}
+
+SearchPool::SearchPool(int threads)
+{
+    setThreads(threads);
+}
+
+SearchPool::~SearchPool()
+{
+    stopHelpers();
+}
+
+void SearchPool::setThreads(int threads)
+{
+    if (threads < 1) threads = 1;
+    stopHelpers();
+    engines.resize(threads);
+    for (auto& e : engines) {
+        if (!e) e = std::make_unique<Engine>();
+        e->stopFlag = &stop;
+        e->nodeCounter = &nodeCount;
+        e->prefetchTT = prefetch;
+    }
+    startHelpers();
+}
+
+void SearchPool::startHelpers()
+{
+    helpers.reserve(engines.size() - 1);
+    for (int i = 1; i < threadCount(); ++i)
+        helpers.emplace_back(&SearchPool::helperLoop, this, i, generation);
+}
+
+void SearchPool::stopHelpers()
+{
+    {
+        std::lock_guard<std::mutex> lock(helperMutex);
+        quitHelpers = true;
+    }
+    helperWake.notify_all();
+    for (auto& t : helpers) t.join();
+    helpers.clear();
+    quitHelpers = false;
+}
+
+/**
+ * @brief Helper thread: sleep until a task is posted, run it, report back.
+ *
+ * @param index Thread index (1..N-1).
+ * @param seenGeneration Generation of the last task this thread ran.
+ */
+void SearchPool::helperLoop(int index, unsigned seenGeneration)
+{
+    while (true) {
+        const std::function<void(int)>* task;
+        {
+            std::unique_lock<std::mutex> lock(helperMutex);
+            helperWake.wait(lock, [&] { return quitHelpers || generation != seenGeneration; });
+            if (quitHelpers) return;
+            seenGeneration = generation;
+            task = helperTask;
+        }
+        (*task)(index);
+        {
+            std::lock_guard<std::mutex> lock(helperMutex);
+            if (--helpersBusy == 0) helperDone.notify_one();
+        }
+    }
+}
+
+void SearchPool::forEachThread(const std::function<void(int)>& task)
+{
+    {
+        std::lock_guard<std::mutex> lock(helperMutex);
+        helperTask = &task;
+        helpersBusy = (int)helpers.size();
+        ++generation;
+    }
+    helperWake.notify_all();
+    task(0);
+    std::unique_lock<std::mutex> lock(helperMutex);
+    helperDone.wait(lock, [this] { return helpersBusy == 0; });
+    helperTask = nullptr;
+}
+
+void SearchPool::setPrefetch(bool enabled)
+{
+    prefetch = enabled;
+    for (auto& e : engines) e->prefetchTT = enabled;
+}
+
+int SearchPool::threadCount() const
+{
+    return (int)engines.size();
+}
+
+void SearchPool::stopSearch()
+{
+    stop.store(true, std::memory_order_relaxed);
+}
+
+void SearchPool::ponderhit()
+{
+    timer.ponderhit();
+}
+
+bool SearchPool::isRunning() const
+{
+    return running.load(std::memory_order_acquire);
+}
+
+void SearchPool::clearTT()
+{
+    if (!TT.beginClear()) return; // Untouched since the last clear
+    int slices = threadCount();
+    forEachThread([slices](int i) { TT.clearSlice(i, slices); });
+}
+
+SearchResult SearchPool::search(const Board& board, int color01, const SearchLimits& limits)
+{
+    start(limits);
+    return run(board, color01, limits);
+}
+
+void SearchPool::start(const SearchLimits& limits)
+{
+    stop.store(false, std::memory_order_relaxed);
+    nodeCount.store(0, std::memory_order_relaxed);
+    if (limits.clockMs > 0)
+        timer.startFromClock(limits.clockMs, limits.incrementMs, limits.moveNumber);
+    else
+        timer.start(limits.timeLimitMs, limits.hardLimitMs);
+    timer.setInfinite(limits.ponder);
+    running.store(true, std::memory_order_release);
+}
+
+SearchResult SearchPool::run(const Board& board, int color01, const SearchLimits& limits)
+{
+    int threads = threadCount();
+    TT.newSearch(); // Entries of previous searches age, before any thread writes
+    liveProgress.begin(color01);
+
+    std::vector<Board> boards(threads, board);
+    std::vector<DeepeningResult> results(threads);
+    std::vector<long> nodesBefore(threads);
+    for (int i = 0; i < threads; ++i) nodesBefore[i] = engines[i]->nodesVisited;
+
+    forEachThread([&](int i) {
+        if (i == 0) {
+            results[0] = searchThread(*engines[0], boards[0], color01, limits, 1, &timer, &liveProgress);
+            stop.store(true, std::memory_order_relaxed); // Helpers search until the main thread is done
+            return;
+        }
+        // Odd helpers skip depth 1, so half of the helpers run one iteration ahead
+        int startDepth = 1 + (i % 2);
+        results[i] = searchThread(*engines[i], boards[i], color01, limits, startDepth, nullptr, nullptr);
+    });
+    running.store(false, std::memory_order_release);
+
+    // Deepest completed iteration wins, main thread on ties
+    SearchResult out;
+    int bestThread = 0;
+    for (int i = 1; i < threads; ++i)
+        if (results[i].depth > results[bestThread].depth && results[i].bestMove.pieceMoved)
+            bestThread = i;
+
+    out.bestMove = remapMove(board, results[bestThread].bestMove);
+    out.score = results[bestThread].score;
+    out.depth = results[bestThread].depth;
+    for (const auto& line : results[bestThread].lines)
+        out.lines.push_back({ remapMove(board, line.move), line.score });
+    out.threadId = bestThread;
+    for (int i = 0; i < threads; ++i) out.nodes += engines[i]->nodesVisited - nodesBefore[i];
+    liveProgress.finish(out.nodes);
+    return out;
+}
@@ -0,0 +1,239 @@
+/**
+ * @file search.h
+ * @brief File declaration for the search driver (iterative deepening, Lazy SMP thread pool).
+ * @version 0.1
+ * @date 2026-01-12
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../Board.h"
+#include "moves.h"
+#include "engine.h"
+#include "timeman.h"
+
+/**
+ * @brief Limits of one search.
+ *
+ */
+struct SearchLimits {
+    int maxDepth = 64;      // Deepest iteration to start
+    int timeLimitMs = 4000; // Soft limit: no new iteration starts after it
+    int hardLimitMs = 0;    // Hard limit: the search is aborted, 0 = same as timeLimitMs
+    int clockMs = 0;        // Remaining game clock of the side to move, 0 = use the fixed limits above
+    int incrementMs = 0;    // Increment per move of the game clock
+    int moveNumber = 1;     // Full move number, spreads the clock over the remaining moves
+    bool ponder = false;    // Ignore the time limits until SearchPool::ponderhit()
+    int multiPV = 1;        // Root moves searched with exact scores (SearchResult::lines)
+};
+
+/**
+ * @brief Root move with its exact score (one MultiPV line).
+ *
+ */
+struct RootLine {
+    Move move;
+    int score; // Side to move perspective
+};
+
+/**
+ * @brief Result of one search.
+ *
+ */
+struct SearchResult {
+    Move bestMove{ {-1,-1}, {-1,-1}, nullptr, nullptr }; // pieceMoved == nullptr if no legal move
+    int score = 0;          // Score from the side to move perspective
+    int depth = 0;          // Deepest completed iteration
+    long nodes = 0;         // Nodes of all threads
+    int threadId = 0;       // Thread that produced bestMove
+    std::vector<RootLine> lines; // MultiPV lines of the deepest iteration, best first (lines[0] is bestMove)
+};
+
+/**
+ * @brief Result of one iterative deepening run.
+ *
+ */
+struct DeepeningResult {
+    Move bestMove{ {-1,-1}, {-1,-1}, nullptr, nullptr }; // First legal move until an iteration completes
+    int score = 0;
+    int depth = 0; // Deepest completed iteration, 0 if none completed
+    std::vector<RootLine> lines;
+};
+
+/**
+ * @brief Iterative deepening of one search thread, shared by SearchPool and ResumableSearch.
+ *
+ * @details Each iteration searches every root move with a full window, once
+ * per MultiPV line, skipping the moves of the better lines. An iteration is
+ * only accepted if all its lines completed, i.e. neither the hard time limit
+ * nor the stop flag cut it short. No new iteration starts after the soft limit,
+ * which the main thread rescales from best move stability and score drops.
+ * Root children are searched by Engine::negamaxResumable() if the engine yields
+ * (yieldEvery > 0) and by Engine::negamax() otherwise, in which case the
+ * coroutine never suspends and runs to the end on its first resume.
+ * Moves are expressed with pointers into @p board.
+ * @param engine Engine owned by this thread.
+ * @param board Board copy owned by this thread.
+ * @param color01 Side to move, 0 = White, 1 = Black.
+ * @param limits Depth limit and MultiPV line count (copied, the task may outlive the caller's limits).
+ * @param startDepth First iteration (staggered for helper threads).
+ * @param timer Clock of the search, nullptr for helpers (stopped through the flag).
+ * @param progress Live progress of the search, nullptr for helpers.
+ * @param result Receives the deepest completed iteration, must outlive the coroutine.
+ * @return Task, its value is the score of @p result.
+ */
+SearchCoro iterativeDeepening(Engine& engine, Board& board, int color01, SearchLimits limits,
+    int startDepth, TimeManager* timer, SearchProgress* progress, DeepeningResult& result);
+
+/**
+ * @brief Lazy SMP search pool.
+ *
+ * Every thread runs its own iterative deepening on its own Board copy and
+ * Engine (history, killers, search stack), all threads share the global TT.
+ * Helper threads start at staggered depths so they fill the TT ahead of the
+ * main thread instead of duplicating its work. The main thread owns the time
+ * manager, it polls the hard limit inside the search and sets the shared stop
+ * flag, helpers are stopped as soon as it finishes. Helper threads live as long
+ * as the pool and are parked on a condition variable between searches.
+ */
+class SearchPool {
+public:
+    /**
+     * @brief Construct the pool.
+     *
+     * @param threads Number of search threads (main thread included).
+     */
+    explicit SearchPool(int threads = 1);
+
+    /**
+     * @brief Wake up and join the parked helper threads.
+     */
+    ~SearchPool();
+
+    SearchPool(const SearchPool&) = delete;
+    SearchPool& operator=(const SearchPool&) = delete;
+
+    /**
+     * @brief Change the number of search threads.
+     *
+     * @param threads Number of threads, clamped to at least 1.
+     */
+    void setThreads(int threads);
+
+    /**
+     * @brief Get number of search threads.
+     *
+     * @return Thread count.
+     */
+    int threadCount() const;
+
+    /**
+     * @brief Enable or disable TT prefetch on make-move for all threads.
+     *
+     * @param enabled True to prefetch (default).
+     */
+    void setPrefetch(bool enabled);
+
+    /**
+     * @brief Search the position with all threads.
+     *
+     * @param board Position to search (copied per thread, not modified).
+     * @param color01 Side to move, 0 = White, 1 = Black.
+     * @param limits Depth and time limits.
+     * @return Best move of the deepest completed iteration.
+     */
+    SearchResult search(const Board& board, int color01, const SearchLimits& limits);
+
+    /**
+     * @brief First half of search(): clear the stop flag, start the clock, mark the pool running.
+     *
+     * @details Lets a caller arm the search under its own lock, so a stopSearch()
+     * or ponderhit() issued from another thread right after it is not lost.
+     * @param limits Time limits of the search.
+     */
+    void start(const SearchLimits& limits);
+
+    /**
+     * @brief Second half of search(): run the threads (after start()).
+     *
+     * @param board Position to search (copied per thread, not modified).
+     * @param color01 Side to move, 0 = White, 1 = Black.
+     * @param limits Depth and time limits.
+     * @return Best move of the deepest completed iteration.
+     */
+    SearchResult run(const Board& board, int color01, const SearchLimits& limits);
+
+    /**
+     * @brief Ask the running search to stop (from another thread).
+     *
+     * @details The search returns the best move of its last completed iteration.
+     * A search that has not started yet resets the flag, call again until it returned.
+     */
+    void stopSearch();
+
+    /**
+     * @brief The pondered move was played: start the clock of the running ponder search.
+     *
+     * @details Call once isRunning() is true, see TimeManager::ponderhit().
+     */
+    void ponderhit();
+
+    /**
+     * @brief Check whether a search is running (its limits and stop flag are set up).
+     *
+     * @return True between the start and the end of search().
+     */
+    bool isRunning() const;
+
+    /**
+     * @brief Live progress of the current (or last) search, readable from any thread without blocking.
+     *
+     * @return Progress published by the main search thread.
+     */
+    const SearchProgress& progress() const { return liveProgress; }
+
+    /**
+     * @brief Run @p task(i) on every search thread i, the calling thread is thread 0.
+     *
+     * @details Wakes the parked helpers and returns once all of them finished the task.
+     * @param task Task, called with the thread index.
+     */
+    void forEachThread(const std::function<void(int)>& task);
+
+    /**
+     * @brief Clear the global TT, one slice per search thread.
+     *
+     * @details Must not be called while a search is running.
+     */
+    void clearTT();
+
+private:
+    void startHelpers();
+    void stopHelpers();
+    void helperLoop(int index, unsigned seenGeneration);
+
+    std::vector<std::unique_ptr<Engine>> engines; // engines[0] belongs to the main thread
+    std::atomic<bool> stop{ false };
+    std::atomic<bool> running{ false };
+    std::atomic<long> nodeCount{ 0 };  // Shared node count, flushed by the threads while searching
+    TimeManager timer;
+    SearchProgress liveProgress;
+    bool prefetch = true;
+
+    std::vector<std::thread> helpers;      // Threads 1..N-1, parked between tasks
+    std::mutex helperMutex;
+    std::condition_variable helperWake;    // New task posted (or quit)
+    std::condition_variable helperDone;    // Last helper finished the task
+    const std::function<void(int)>* helperTask = nullptr;
+    unsigned generation = 0;               // Incremented per posted task
+    int helpersBusy = 0;                   // Helpers still running the task
+    bool quitHelpers = false;
+};
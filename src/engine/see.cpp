@@ -3,150 +3,91 @@
  * @brief File implementation for static exchange evaluation.
  * @version 0.1
  * @date 2026-01-12
- * 
+ *
  * @copyright Copyright (c) 2026
- * 
+ *
  */
 #include "../Piece.h"
 #include "../Board.h"
-#include "val.h" 
+#include "val.h"
+#include "see.h"
+#include "bitboard.h"
 #include <algorithm>
-#include <vector>
-#include <cmath>
-
-// Helper border check, inline makes it faster
-
-/**
- * @brief Check whether valid.
- *
- * @details Returns a boolean condition derived from current state/arguments.
- * @param r Parameter.
- * @param c Parameter.
- * @return True if the condition holds; otherwise false.
- */
-inline bool isValid(int r, int c) {
-    return r >= 0 && r < 8 && c >= 0 && c < 8;
-}
 
-// Stable directions for pieces
-static int knightDeltas[8][2] = { {2, 1}, {1, 2}, {-1, 2}, {-2, 1}, {-2, -1}, {-1, -2}, {1, -2}, {2, -1} };
-static int rookDeltas[4][2] = { {1, 0}, {-1, 0}, {0, 1}, {0, -1} };
-static int bishopDeltas[4][2] = { {1, 1}, {1, -1}, {-1, 1}, {-1, -1} };
+// Exchange values per PieceType, same as pieceValFromSymbol()
+static const int seeValues[PIECE_TYPE_NB] = { 100, 320, 350, 500, 1500, 20000 };
 
-/// Find cheapest attacker of given color on target square.
-/// Returns position of attacker and sets outValue to its value.
-/// If no attacker found, returns {-1,-1} and outValue is undefined.
-static Position getCheapestAttacker(Board& board, Position target, int color, int& outValue)
+/// Find least valuable piece among @p attackers of given color.
+/// Returns its square bitboard and sets outType, or returns 0 if none.
+static Bitboard leastValuableAttacker(const BoardBitboards& bb, Bitboard attackers, int color, int& outType)
 {
-    Position bestPos = { -1, -1 };
-    int bestVal = 100000; // INF
-
-    int r = target.row;
-    int c = target.col;
-
-    /// PAWN
-	/// We check where a pawn of given color could attack from.
-	/// so pawn has to be on r-1 (white) or r+1 (black)
-    /// moves.cpp: White=+1, Black=-1.
-	/// Attacker is r-1 for White, r+1 for Black
-
-	int pawnDir = (color == 0) ? -1 : 1; // Where did the pawn come from
-
-    // Check for both diagonals
-    for (int dc : {-1, 1}) {
-        int pr = r + pawnDir;
-        int pc = c + dc;
-        if (isValid(pr, pc)) {
-            Piece* p = board.getPieceAt({ pr, pc });
-            if (p && p->getColor() == color && toupper(p->getSymbol()) == 'P') {
-				// Pawn is always the cheapest attacker
-                outValue = pieceValFromSymbol(p->symbol);
-				return { pr, pc }; // Pawn found, return immediately cause can't be cheaper
-            }
-        }
-    }
-
-	/// KNIGHT
-    for (auto& d : knightDeltas) {
-        int nr = r + d[0];
-        int nc = c + d[1];
-        if (isValid(nr, nc)) {
-            Piece* p = board.getPieceAt({ nr, nc });
-            if (p && p->getColor() == color && toupper(p->getSymbol()) == 'N') {
-				int val = pieceValFromSymbol(p->symbol); // Knight value
-                if (val < bestVal) {
-                    bestVal = val;
-                    bestPos = { nr, nc };
-                }
-            }
+    Bitboard own = attackers & bb.byColor[color];
+    if (!own) return 0;
+    for (int type = PAWN; type <= KING; ++type) {
+        Bitboard subset = own & bb.byType[type];
+        if (subset) {
+            outType = type;
+            return subset & (0 - subset); // Lowest set bit
         }
     }
+    return 0;
+}
 
-	// Theoretically we could have multiple attackers of same type,
-	// so we continue searching for cheaper ones.
-	// Even if we found a knight, we still look for bishops, rooks, queens, kings.
-
-	// SLIDERS: BISHOP, ROOK, QUEEN
-	// Helper for scanning in directions
-    auto scan = [&](int dirs[][2], int numDirs, char type1, char type2) {
-        for (int i = 0; i < numDirs; ++i) {
-            for (int k = 1; k < 8; ++k) {
-                int nr = r + dirs[i][0] * k;
-                int nc = c + dirs[i][1] * k;
-
-                if (!isValid(nr, nc)) break;
-
-                Piece* p = board.getPieceAt({ nr, nc });
-                if (p) { // Found
-                    if (p->getColor() == color) {
-                        char s = toupper(p->getSymbol());
-                        if (s == type1 || s == type2 || s == 'Q') {
-                            int val = pieceValFromSymbol(s);
-                            if (val < bestVal) {
-                                bestVal = val;
-                                bestPos = { nr, nc };
-                            }
-                        }
-                    }
-                    break; // Blocked, stop
-                }
-            }
-        }
-        };
-
-    // Diagonals
-	/**
- * @brief Perform scan.
+/**
+ * @brief Perform swap-list exchange evaluation.
  *
- * @details Implements the behavior implied by the function name.
- * @param bishopDeltas Parameter.
- * @param B Parameter.
- * @param B Parameter.
- * @return Result of the operation.
+ * @details Classic swap algorithm: pieces are removed from a local occupancy
+ * copy as they capture, which uncovers sliders behind them (x-rays).
+ * The board and the snapshot are never modified and the gain list is a fixed
+ * array (at most 32 pieces can take part in an exchange).
+ * @param bb Bitboard snapshot of the board.
+ * @param from Square of the first capturer.
+ * @param to Target square.
+ * @param moverType PieceType of the first capturer.
+ * @param victimValue Value of the piece on @p to (0 for a quiet move).
+ * @return Material gain of the side making the first capture.
  */
-	scan(bishopDeltas, 4, 'B', 'B'); // Double Bishop
-    // Straights
-    scan(rookDeltas, 4, 'R', 'R');
-
-    //KING
-    for (auto& d : bishopDeltas) { // Moves like a Queen but only one square
-		// Simplified checking for area around king
-		// This is not very efficient but king is rare so it's ok
-        int nr = r + d[0]; int nc = c + d[1];
-        if (isValid(nr, nc)) {
-            Piece* p = board.getPieceAt({ nr, nc });
-            if (p && p->getColor() == color && toupper(p->getSymbol()) == 'K') {
-				// We take king only if there is no other choice
-                if (20000 < bestVal) { bestVal = 20000; bestPos = { nr, nc }; }
-            }
-        }
+static int seeSwap(const BoardBitboards& bb, int from, int to, int moverType, int victimValue)
+{
+    int gain[32];
+    int d = 0;
+
+    Bitboard occ = bb.occupied;
+    Bitboard fromSet = squareBB(from);
+    Bitboard diagonalSliders = bb.byType[BISHOP] | bb.byType[QUEEN];
+    Bitboard straightSliders = bb.byType[ROOK] | bb.byType[QUEEN];
+    Bitboard attackers = bb.attackersTo(to, occ);
+
+    int stm = (bb.byColor[0] & fromSet) ? 0 : 1;
+    int attackerType = moverType;
+    gain[0] = victimValue;
+
+    while (true) {
+        ++d;
+        // Speculative: piece on target is captured back
+        gain[d] = seeValues[attackerType] - gain[d - 1];
+        if (std::max(-gain[d - 1], gain[d]) < 0) break; // Neither side can improve, stop
+
+        // Remove capturer, reveal x-ray attackers behind it
+        // (the first mover of a quiet move is not an attacker of the target)
+        occ &= ~fromSet;
+        attackers |= (bishopAttacks(to, occ) & diagonalSliders) | (rookAttacks(to, occ) & straightSliders);
+        attackers &= occ;
+
+        stm = 1 - stm;
+        fromSet = leastValuableAttacker(bb, attackers, stm, attackerType);
+        if (!fromSet || d >= 31) break;
+
+        // King cannot capture into a square that is still attacked
+        if (attackerType == KING && (attackers & bb.byColor[1 - stm])) break;
     }
 
-    outValue = bestVal;
-    return bestPos;
+    // Back-propagation, each side may stop capturing if it does not pay
+    while (--d)
+        gain[d - 1] = -std::max(-gain[d - 1], gain[d]);
+    return gain[0];
 }
 
-
 /**
  * @brief Perform see.
  *
@@ -156,65 +97,54 @@ static Position getCheapestAttacker(Board& board, Position target, int color, in
  * @param sideToMove Move data/descriptor.
  * @return Integer result.
  */
-
 int see(Board& board, Position target, int sideToMove)
 {
-	// Starting value of the victim
-    Piece* victim = board.getPieceAt(target);
-    int value = victim ? pieceValFromSymbol(victim->getSymbol()) : 0;
-
-    // Swap list
-    std::vector<int> gain;
-    gain.reserve(16);
-    gain.push_back(value);
-
-	// For optimal performance, we could try to delete one figure 
-	// in cache but its tricky and error-prone.
-	// We stay with simple copy for safety. (Maybe we can optimize later?)
+    BoardBitboards bb(board);
+    int to = target.row * 8 + target.col;
 
-    Board copy = board; // Only one copy
+    int moverType = PIECE_TYPE_NB;
+    Bitboard fromSet = leastValuableAttacker(bb, bb.attackersTo(to, bb.occupied), sideToMove, moverType);
+    if (!fromSet) return 0; // No captures at all
 
-    int stm = sideToMove;
-
-    while (true)
-    {
-        int attackerValue = 0;
-        Position from = getCheapestAttacker(copy, target, stm, attackerValue);
-
-		// If no attacker found, stop
-        if (from.row == -1) {
-			if (gain.size() == 1) return 0; // No captures at all
-            break;
-        }
-
-		// New value after capture, new victim is the attacker
-        gain.push_back(attackerValue);
-
-		// Pseudo move the attacker to the target square
-		// We then open up the x-ray attacks for the next iteration
-        Piece* attackerPiece = copy.getPieceAt(from);
-        copy.movePiece(from, target, attackerPiece); // target now has the attacker
-
-        // Switch sides
-        stm = (stm == 0) ? 1 : 0;
+    Piece* victim = board.getPieceAt(target);
+    int value = victim ? pieceValFromSymbol(victim->getSymbol()) : 0;
+    return seeSwap(bb, lsb(fromSet), to, moverType, value);
+}
 
-		// Optional - if king is the attacker, stop immediately, since we don't want to consider further captures
-        if (toupper(attackerPiece->getSymbol()) == 'K') break;
-    }
+/**
+ * @brief Perform see for a given move using a prebuilt snapshot.
+ *
+ * @param bb Bitboard snapshot of the board before the move.
+ * @param move Move to evaluate.
+ * @return Integer result.
+ */
+int seeMove(const BoardBitboards& bb, const Move& move)
+{
+    int from = move.from.row * 8 + move.from.col;
+    int to = move.to.row * 8 + move.to.col;
+    if (!(bb.occupied & squareBB(from))) return 0;
 
-    // Back-propagation
-    // gain[0] is the value of first capture
-	// gain[1] is value of the attacker, that captures first victim
-    // EQ: score = val_captured - see(next)
+    int moverType = PIECE_TYPE_NB;
+    for (int type = PAWN; type <= KING; ++type)
+        if (bb.byType[type] & squareBB(from)) { moverType = type; break; }
 
-    int sz = gain.size();
-	int score = 0; // If we stop at the last move ergo no more attackers, score is 0
+    int victimValue = 0;
+    for (int type = PAWN; type <= KING; ++type)
+        if (bb.byType[type] & squareBB(to)) { victimValue = seeValues[type]; break; }
 
-    // Iterate to the end of the list
-    for (int i = sz - 1; i >= 1; --i) {
-        score = std::max(0, gain[i] - score);
-    }
+    return seeSwap(bb, from, to, moverType, victimValue);
+}
 
-    // Return sidetomove score
-    return gain[0] - score;
-}
\ No newline at end of file
+/**
+ * @brief Perform see for a given move.
+ *
+ * @details Builds a bitboard snapshot and evaluates the move with it.
+ * @param board Board state to operate on (not modified).
+ * @param move Move to evaluate.
+ * @return Integer result.
+ */
+int seeMove(Board& board, const Move& move)
+{
+    BoardBitboards bb(board);
+    return seeMove(bb, move);
+}
@@ -0,0 +1,49 @@
+/**
+ * @file see.h
+ * @brief File declaration for static exchange evaluation.
+ * @version 0.1
+ * @date 2026-01-12
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+#pragma once
+#include "../Board.h"
+#include "moves.h"
+
+/**
+ * @brief Static exchange evaluation of a capture sequence on @p target.
+ *
+ * @details @p sideToMove captures first with its cheapest attacker, then both sides
+ * keep recapturing with their cheapest attackers (and may stop when it does not pay).
+ * @param board Board state to operate on.
+ * @param target Square where the exchange happens.
+ * @param sideToMove Side that captures first (0 = White, 1 = Black).
+ * @return Material gain of @p sideToMove, 0 if it has no attacker.
+ */
+int see(Board& board, Position target, int sideToMove);
+
+/**
+ * @brief Static exchange evaluation of a specific move.
+ *
+ * @details Plays @p move (quiet or capture) and lets the opponent start the exchange
+ * on the to-square if that pays. Negative results mean the moved piece is lost
+ * for less than its value (bad capture / hanging quiet move).
+ * @param board Board state (not modified).
+ * @param move Move to evaluate.
+ * @return Expected material balance of the move for the side making it.
+ */
+int seeMove(Board& board, const Move& move);
+
+struct BoardBitboards;
+
+/**
+ * @brief Static exchange evaluation of a specific move on a prebuilt bitboard snapshot.
+ *
+ * @details Same as seeMove(Board&, const Move&), but lets callers build the snapshot
+ * once per node and evaluate many moves with it. Allocation free, never touches the board.
+ * @param bb Bitboard snapshot of the position before the move.
+ * @param move Move to evaluate.
+ * @return Expected material balance of the move for the side making it.
+ */
+int seeMove(const BoardBitboards& bb, const Move& move);
@@ -1,4 +1,15 @@
 #include "TT.h"
+#include <fstream>
+#include <new>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
 
 /**
  * @brief Perform t t.
@@ -6,4 +17,133 @@
  * @details Implements the behavior implied by the function name.
  * @return Result of the operation.
  */
-TranspositionTable TT(64);
\ No newline at end of file
+TranspositionTable TT(64);
+
+// Huge page size used for alignment (x86-64 / AArch64 transparent huge pages)
+static const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+/// Read the transparent huge page mode, e.g. "always [madvise] never" -> "madvise".
+static std::string transparentHugePageMode()
+{
+    std::ifstream in("/sys/kernel/mm/transparent_hugepage/enabled");
+    std::string line;
+    if (!in || !std::getline(in, line)) return "unknown";
+    size_t open = line.find('['), close = line.find(']');
+    if (open == std::string::npos || close == std::string::npos || close < open) return "unknown";
+    return line.substr(open + 1, close - open - 1);
+}
+
+TranspositionTable::~TranspositionTable()
+{
+    release();
+}
+
+/**
+ * @brief Free the current allocation.
+ *
+ */
+void TranspositionTable::release()
+{
+    if (!base) return;
+#if defined(_WIN32)
+    VirtualFree(base, 0, MEM_RELEASE);
+#else
+    munmap(base, allocatedBytes);
+#endif
+    base = nullptr;
+    table = nullptr;
+    allocatedBytes = 0;
+    size = 0;
+    mask = 0;
+}
+
+/**
+ * @brief Reallocate the table with a power-of-two cluster count.
+ *
+ * @details Memory comes straight from the OS (mmap / VirtualAlloc), so it is
+ * zero-filled, which is the empty state of every entry. On Linux the block is
+ * aligned to 2 MB and advised for transparent huge pages, a 64 MB table then
+ * needs 32 TLB entries instead of 16384.
+ * @param sizeInMB Table size in megabytes.
+ */
+void TranspositionTable::resize(size_t sizeInMB)
+{
+    release();
+    if (sizeInMB < 1) sizeInMB = 1;
+
+    size_t clusters = 1;
+    while (clusters * 2 * sizeof(TTCluster) <= sizeInMB * 1024 * 1024) clusters *= 2;
+    size_t bytes = clusters * sizeof(TTCluster);
+
+#if defined(_WIN32)
+    // Large pages need SeLockMemoryPrivilege, use regular pages
+    base = VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if (!base) throw std::bad_alloc();
+    allocatedBytes = bytes;
+    table = reinterpret_cast<TTCluster*>(base);
+    pageStatus = "huge pages: not used (Windows)";
+#else
+    // Over-allocate so the table can start on a huge page boundary
+    allocatedBytes = bytes + HUGE_PAGE_SIZE;
+    base = mmap(nullptr, allocatedBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) {
+        base = nullptr;
+        allocatedBytes = 0;
+        throw std::bad_alloc();
+    }
+    size_t addr = reinterpret_cast<size_t>(base);
+    size_t aligned = (addr + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+    table = reinterpret_cast<TTCluster*>(aligned);
+#if defined(MADV_HUGEPAGE)
+    if (madvise(table, bytes, MADV_HUGEPAGE) == 0)
+        pageStatus = "huge pages: requested (THP mode " + transparentHugePageMode() + ")";
+    else
+        pageStatus = "huge pages: madvise failed (THP mode " + transparentHugePageMode() + ")";
+#else
+    pageStatus = "huge pages: not supported on this platform";
+#endif
+#endif
+
+    size = clusters;
+    mask = clusters - 1;
+    generation = 0;
+    dirty.store(false, std::memory_order_relaxed); // Fresh pages are zero, touched lazily on first use
+}
+
+void TranspositionTable::clear()
+{
+    if (beginClear())
+        clearSlice(0, 1);
+}
+
+bool TranspositionTable::beginClear()
+{
+    generation = 0;
+    if (!dirty.load(std::memory_order_relaxed)) return false;
+    dirty.store(false, std::memory_order_relaxed);
+    return true;
+}
+
+void TranspositionTable::clearSlice(int index, int count)
+{
+    size_t perSlice = size / count;
+    size_t begin = index * perSlice;
+    size_t end = index + 1 < count ? begin + perSlice : size;
+    for (size_t i = begin; i < end; ++i)
+        for (int j = 0; j < TT_CLUSTER_SIZE; ++j) {
+            table[i].check[j].store(0, std::memory_order_relaxed);
+            table[i].data[j].store(0, std::memory_order_relaxed);
+        }
+}
+
+int TranspositionTable::hashfull() const
+{
+    int used = 0;
+    int sampled = 0;
+    for (size_t i = 0; i < size && sampled < 1000; ++i)
+        for (int j = 0; j < TT_CLUSTER_SIZE && sampled < 1000; ++j, ++sampled) {
+            unsigned long long data = table[i].data[j].load(std::memory_order_relaxed);
+            if (data != 0 && dataGeneration(data) == generation) ++used;
+        }
+    return sampled ? used * 1000 / sampled : 0;
+}
@@ -3,50 +3,159 @@
  * @brief File declaration for Transposition Table.
  * @version 0.1
  * @date 2026-01-12
- * 
+ *
  * @copyright Copyright (c) 2026
- * 
+ *
  */
 #pragma once
-#include <vector>
+#include <atomic>
+#include <cstddef>
+#include <string>
+#if defined(_MSC_VER)
+#include <xmmintrin.h>
+#endif
 #include "../moves.h"
+#include "../val.h"
 
 /**
  * @brief Transposition Table Flags
- * 
+ *
  */
 enum TTFlag {
     TT_EXACT,   // Exact
-    TT_ALPHA,   // Upper Bound 
-    TT_BETA     // Lower Bound 
+    TT_ALPHA,   // Upper Bound
+    TT_BETA     // Lower Bound
 };
+
+/**
+ * @brief Pack a move into 16 bits: from (6) | to (6) | promotion (3).
+ *
+ * @details Piece pointers are not stored, they would be invalid in another
+ * thread's board copy anyway. Match with sameMove() against generated moves.
+ * @param move Move to pack.
+ * @return Packed move, 0 for "no move".
+ */
+inline unsigned short packMove(const Move& move) {
+    if (move.from.row < 0 || move.to.row < 0) return 0;
+    unsigned promo = 0;
+    switch (move.promotion) {
+    case 'N': promo = 1; break;
+    case 'B': promo = 2; break;
+    case 'R': promo = 3; break;
+    case 'Q': promo = 4; break;
+    }
+    unsigned from = move.from.row * 8 + move.from.col;
+    unsigned to = move.to.row * 8 + move.to.col;
+    return (unsigned short)(from | (to << 6) | (promo << 12));
+}
+
+/**
+ * @brief Unpack a move packed by packMove().
+ *
+ * @param packed Packed move.
+ * @return Move with squares and promotion, piece pointers are nullptr
+ * (squares are -1 for "no move").
+ */
+inline Move unpackMove(unsigned short packed) {
+    static const char promos[5] = { 0, 'N', 'B', 'R', 'Q' };
+    Move m{ {-1,-1}, {-1,-1}, nullptr, nullptr };
+    if (packed == 0) return m;
+    unsigned from = packed & 63, to = (packed >> 6) & 63, promo = (packed >> 12) & 7;
+    m.from = { (int)(from / 8), (int)(from % 8) };
+    m.to = { (int)(to / 8), (int)(to % 8) };
+    m.promotion = promo <= 4 ? promos[promo] : 0;
+    return m;
+}
+
+/**
+ * @brief Convert a search score to its TT form.
+ *
+ * @details Mate scores are relative to the root (MATE_SCORE - plies from root).
+ * The TT stores them relative to the node instead, so an entry probed at
+ * another ply still gives the right distance.
+ * @param score Score at the node.
+ * @param ply Distance of the node from the root.
+ * @return Score to store.
+ */
+inline int scoreToTT(int score, int ply) {
+    if (score > MATE_BOUND) return score + ply;
+    if (score < -MATE_BOUND) return score - ply;
+    return score;
+}
+
 /**
- * @brief Transposition Table Entry
- * 
+ * @brief Convert a TT score back to a root-relative search score.
+ *
+ * @param score Stored score.
+ * @param ply Distance of the probing node from the root.
+ * @return Score at the node.
  */
-struct TTEntry {
-    unsigned long long key; // Collision
-    int score;
-    int depth;
-    TTFlag flag;
-    Move bestMove;         
+inline int scoreFromTT(int score, int ply) {
+    if (score > MATE_BOUND) return score - ply;
+    if (score < -MATE_BOUND) return score + ply;
+    return score;
+}
+
+/**
+ * @brief Static eval stored when none was computed.
+ *
+ */
+const int TT_EVAL_NONE = -32768;
+
+/**
+ * @brief Number of entries in one cluster.
+ *
+ */
+const int TT_CLUSTER_SIZE = 6;
+
+/**
+ * @brief Cache-line sized bucket of packed entries sharing one index.
+ *
+ * @details An entry is 10 bytes split in two words:
+ * - data (64 bits): move (16) | score (16) | static eval (16) | depth (8) | flag (2) + generation (6),
+ * - check (16 bits): top 16 key bits XOR the 16-bit fold of data.
+ *
+ * Lockless: a torn entry (data and check written by different threads) fails
+ * the check and reads as a miss, so no lock is needed. The cluster index
+ * already encodes the low key bits, so the 16 stored bits verify the rest.
+ */
+struct alignas(64) TTCluster {
+    std::atomic<unsigned short> check[TT_CLUSTER_SIZE];
+    unsigned int padding;
+    std::atomic<unsigned long long> data[TT_CLUSTER_SIZE];
 };
+static_assert(sizeof(TTCluster) == 64, "TTCluster must fill exactly one cache line");
+
 /**
  * @brief Transposition Table
- * 
+ *
+ * @details A key selects a cluster, one cache line holding 6 entries. Replacement
+ * inside the cluster prefers the entry with the lowest depth - 8 * age, where
+ * age is the number of searches since the entry was written, so deep results
+ * survive shallow ones while old searches fade out.
  */
 class TranspositionTable {
 public:
     /**
-     * @brief Transposition Table data storage.
-     * 
+     * @brief Transposition Table data storage (zero-filled pages from allocateClusters()).
+     *
+     */
+    TTCluster* table = nullptr;
+    /**
+     * @brief Transposition Table size (number of clusters, a power of two).
+     *
      */
-    std::vector<TTEntry> table;
+    size_t size = 0;
     /**
-     * @brief Transposition Table size.
-     * 
+     * @brief Index mask, size - 1.
+     *
      */
-    int size;
+    size_t mask = 0;
+    /**
+     * @brief Current search generation (6 bits), see newSearch().
+     *
+     */
+    unsigned generation = 0;
 
     /**
      * @brief Perform transposition table.
@@ -55,21 +164,134 @@ public:
      * @param sizeInMB Parameter.
      * @return Result of the operation.
      */
-    TranspositionTable(int sizeInMB) {
-		// How many entries fit in the given size
-        int entrySize = sizeof(TTEntry);
-        int numEntries = (sizeInMB * 1024 * 1024) / entrySize;
-        table.resize(numEntries);
-        size = numEntries;
-    }
+    TranspositionTable(size_t sizeInMB) { resize(sizeInMB); }
+    ~TranspositionTable();
+    TranspositionTable(const TranspositionTable&) = delete;
+    TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+    /**
+     * @brief Reallocate the table, all entries are lost.
+     *
+     * @details The cluster count is the largest power of two fitting in
+     * @p sizeInMB, so a key is mapped with a mask instead of a 64-bit modulo.
+     * Must not be called while a search is running.
+     * @param sizeInMB Table size in megabytes (at least 1).
+     */
+    void resize(size_t sizeInMB);
+
+    /**
+     * @brief Size of the table in megabytes.
+     *
+     * @return Allocated megabytes.
+     */
+    size_t sizeMB() const { return size * sizeof(TTCluster) / (1024 * 1024); }
+
+    /**
+     * @brief Table usage of the current search.
+     *
+     * @details Samples the first 1000 entries, only entries written in the
+     * current generation count, so the figure restarts with every search.
+     * @return Used entries per mille.
+     */
+    int hashfull() const;
+
+    /**
+     * @brief Human readable huge page status of the current allocation.
+     *
+     * @return Status line for the log.
+     */
+    const std::string& hugePageStatus() const { return pageStatus; }
 
     /**
      * @brief Perform clear.
      *
-     * @details Implements the behavior implied by the function name.
+     * @details Zeroes the whole table on the calling thread, see beginClear()
+     * and clearSlice() to split the work across the search threads.
+     * Must not be called while a search is running.
+     */
+    void clear();
+
+    /**
+     * @brief Start a clear: reset the aging and mark the table clean.
+     *
+     * @details A table that has not been written since the last clear/resize
+     * is still all zero, so a "New Game" right after startup costs nothing.
+     * @return True if the entries still have to be zeroed with clearSlice().
+     */
+    bool beginClear();
+
+    /**
+     * @brief Zero one contiguous slice of the table.
+     *
+     * @details Entries are zeroed through their atomics (relaxed stores), so
+     * slices can be cleared concurrently. Nothing may probe or store meanwhile.
+     * @param index Slice to clear, 0 <= index < count.
+     * @param count Number of slices the table is split into.
+     */
+    void clearSlice(int index, int count);
+
+    /**
+     * @brief Start a new search: entries of older searches age by one.
+     *
+     */
+    void newSearch() {
+        generation = (generation + 1) & GEN_MASK;
+    }
+
+    /**
+     * @brief Pack entry fields into the data word.
+     *
+     * @details Score and eval are clamped to 16 bits (mate scores fit, see MATE_SCORE).
+     */
+    static unsigned long long packData(int score, int depth, TTFlag flag, const Move& bestMove,
+        int staticEval = TT_EVAL_NONE, unsigned gen = 0) {
+        if (depth < 0) depth = 0;
+        if (depth > 255) depth = 255;
+        return (unsigned long long)packMove(bestMove)
+            | ((unsigned long long)(unsigned short)clamp16(score) << 16)
+            | ((unsigned long long)(unsigned short)(staticEval == TT_EVAL_NONE ? TT_EVAL_NONE : clamp16(staticEval)) << 32)
+            | ((unsigned long long)depth << 48)
+            | ((unsigned long long)(flag | ((gen & GEN_MASK) << 2)) << 56);
+    }
+
+    static unsigned short dataMove(unsigned long long data) { return (unsigned short)(data & 0xFFFF); }
+    static int dataScore(unsigned long long data) { return (short)(data >> 16); }
+    static int dataEval(unsigned long long data) { return (short)(data >> 32); }
+    static int dataDepth(unsigned long long data) { return (int)((data >> 48) & 0xFF); }
+    static TTFlag dataFlag(unsigned long long data) { return (TTFlag)((data >> 56) & 3); }
+    static unsigned dataGeneration(unsigned long long data) { return (unsigned)((data >> 58) & GEN_MASK); }
+
+    /**
+     * @brief Check word of an entry: top 16 key bits XOR the 16-bit fold of data.
+     *
+     */
+    static unsigned short checkWord(unsigned long long key, unsigned long long data) {
+        return (unsigned short)((key >> 48) ^ data ^ (data >> 16) ^ (data >> 32) ^ (data >> 48));
+    }
+
+    /**
+     * @brief Get the cluster a key maps to.
+     *
+     * @param key Zobrist key.
+     * @return Cluster reference.
+     */
+    TTCluster& clusterFor(unsigned long long key) {
+        return table[key & mask];
+    }
+
+    /**
+     * @brief Start loading the cluster of @p key into the cache.
+     *
+     * @details Issued from make-move so the memory latency overlaps with the
+     * rest of the move and the repetition check before the probe.
+     * @param key Zobrist key of the position about to be probed.
      */
-    void clear() {
-        std::fill(table.begin(), table.end(), TTEntry{ 0, 0, 0, TT_EXACT, Move() });
+    void prefetch(unsigned long long key) const {
+#if defined(_MSC_VER)
+        _mm_prefetch(reinterpret_cast<const char*>(&table[key & mask]), _MM_HINT_T0);
+#else
+        __builtin_prefetch(&table[key & mask]);
+#endif
     }
 
     // Save position
@@ -82,30 +304,49 @@ public:
      * @param depth Search depth in plies.
      * @param flag Parameter.
      * @param bestMove Move data/descriptor.
+     * @param staticEval Static eval of the position, TT_EVAL_NONE if not computed.
+     * @param ply Distance from the root, mate scores are stored relative to the node.
      */
-    void store(unsigned long long key, int score, int depth, TTFlag flag, Move bestMove) {
-        int index = key % size;
+    void store(unsigned long long key, int score, int depth, TTFlag flag, Move bestMove,
+        int staticEval = TT_EVAL_NONE, int ply = 0) {
+        TTCluster& cluster = clusterFor(key);
+        int replace = -1;
+        int replaceWorth = 0;
+        unsigned short move = packMove(bestMove);
 
-		// Always preserve the entry with the greatest depth
-		// Always overwrite for simplicity
-        TTEntry& entry = table[index];
-
-        if (entry.key == key) {
-            if (depth >= entry.depth) {
-                entry.score = score;
-                entry.depth = depth;
-                entry.flag = flag;
-                entry.bestMove = bestMove;
+        for (int i = 0; i < TT_CLUSTER_SIZE; ++i) {
+            unsigned long long oldData = cluster.data[i].load(std::memory_order_relaxed);
+            unsigned short oldCheck = cluster.check[i].load(std::memory_order_relaxed);
+            if (oldData == 0 || oldCheck == checkWord(key, oldData)) {
+                // Same position: a deeper bound of the current search survives a shallower
+                // bound, but takes over its move. An exact result always replaces it.
+                if (oldData != 0 && flag != TT_EXACT && depth < dataDepth(oldData)
+                    && dataGeneration(oldData) == generation) {
+                    if (move != 0 && move != dataMove(oldData)) {
+                        unsigned long long kept = (oldData & ~0xFFFFULL) | move;
+                        cluster.data[i].store(kept, std::memory_order_relaxed);
+                        cluster.check[i].store(checkWord(key, kept), std::memory_order_relaxed);
+                    }
+                    return;
+                }
+                if (oldData != 0 && move == 0)
+                    move = dataMove(oldData); // Fail-low result has no move, keep the known one
+                replace = i;
+                break;
+            }
+            // Other position: candidate for replacement, lowest depth - age wins
+            int age = (int)((generation - dataGeneration(oldData)) & GEN_MASK);
+            int worth = dataDepth(oldData) - 8 * age;
+            if (replace < 0 || worth < replaceWorth) {
+                replace = i;
+                replaceWorth = worth;
             }
         }
-        else {
-            // Always overwrite
-            entry.key = key;
-            entry.score = score;
-            entry.depth = depth;
-            entry.flag = flag;
-            entry.bestMove = bestMove;
-        }
+
+        if (!dirty.load(std::memory_order_relaxed)) dirty.store(true, std::memory_order_relaxed); // Read-mostly, no shared-line writes
+        unsigned long long data = packData(scoreToTT(score, ply), depth, flag, unpackMove(move), staticEval, generation);
+        cluster.data[replace].store(data, std::memory_order_relaxed);
+        cluster.check[replace].store(checkWord(key, data), std::memory_order_relaxed);
     }
 
     // Read position
@@ -119,39 +360,59 @@ public:
      * @param beta Alpha-beta bound.
      * @param outScore Parameter.
      * @param outMove Move data/descriptor.
+     * @param outEval Optional, receives the stored static eval on a hit (TT_EVAL_NONE otherwise).
+     * @param ply Distance from the root, mate scores are converted back to root-relative.
      * @return True if the condition holds; otherwise false.
      */
-    bool probe(unsigned long long key, int depth, int alpha, int beta, int& outScore, Move& outMove) {
+    bool probe(unsigned long long key, int depth, int alpha, int beta, int& outScore, Move& outMove,
+        int* outEval = nullptr, int ply = 0) {
+        if (outEval) *outEval = TT_EVAL_NONE;
         if (key == 0) return false;
-        int index = key % size;
-        TTEntry& entry = table[index];
-        if (entry.key == 0) return false;
+        TTCluster& cluster = clusterFor(key);
+        for (int i = 0; i < TT_CLUSTER_SIZE; ++i) {
+            unsigned long long data = cluster.data[i].load(std::memory_order_relaxed);
+            unsigned short check = cluster.check[i].load(std::memory_order_relaxed);
+            if (data == 0 || check != checkWord(key, data)) continue; // Empty, other position or torn write
 
-        if (entry.key == key) { // Hit
-			outMove = entry.bestMove; // Always return best move
+            outMove = unpackMove(dataMove(data)); // Always return best move
+            if (outEval) *outEval = dataEval(data);
 
-            if (entry.depth >= depth) { // Only if reached depth
-                if (entry.flag == TT_EXACT) {
-                    outScore = entry.score;
+            if (dataDepth(data) >= depth) { // Only if reached depth
+                int score = scoreFromTT(dataScore(data), ply);
+                TTFlag flag = dataFlag(data);
+                if (flag == TT_EXACT) {
+                    outScore = score;
                     return true;
                 }
-                if (entry.flag == TT_ALPHA && entry.score <= alpha) {
+                if (flag == TT_ALPHA && score <= alpha) {
                     outScore = alpha;
                     return true;
                 }
-                if (entry.flag == TT_BETA && entry.score >= beta) {
+                if (flag == TT_BETA && score >= beta) {
                     outScore = beta;
                     return true;
                 }
             }
+            return false;
         }
         return false;
     }
+
+private:
+    static const unsigned GEN_MASK = 63;
+    void* base = nullptr;       // Start of the OS allocation (table may be aligned inside it)
+    size_t allocatedBytes = 0;
+    std::string pageStatus;
+    std::atomic<bool> dirty{ true }; // Entries may be non-zero (written since the last clear)
+
+    void release();
+
+    static int clamp16(int v) { return v < -32767 ? -32767 : (v > 32767 ? 32767 : v); }
 };
 
 // 64 MB Transposition Table instance
 /**
  * @brief Global Transposition Table instance
- * 
+ *
  */
-extern TranspositionTable TT;
\ No newline at end of file
+extern TranspositionTable TT;
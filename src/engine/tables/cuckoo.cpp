@@ -0,0 +1,66 @@
+/**
+ * @file cuckoo.cpp
+ * @brief Cuckoo table of reversible move keys.
+ *
+ * Every move of a non-pawn piece between two squares on an empty board is
+ * reversible. Its key is the XOR of the position keys before and after it, so
+ * the difference of two position keys can be looked up to find out whether one
+ * move connects them (upcoming repetition detection in the search).
+ */
+#include "cuckoo.h"
+#include "zobrist.h"
+#include "../bitboard.h"
+#include <utility>
+
+unsigned long long cuckooKeys[CUCKOO_SIZE];
+unsigned short cuckooMoves[CUCKOO_SIZE];
+
+/**
+ * @brief Empty-board attacks of a non-pawn piece.
+ *
+ * @param type PieceType (KNIGHT..KING).
+ * @param sq Origin square.
+ * @return Attacked squares.
+ */
+static Bitboard emptyBoardAttacks(int type, int sq)
+{
+    switch (type) {
+    case KNIGHT: return knightAttacks[sq];
+    case BISHOP: return bishopAttacks(sq, 0);
+    case ROOK:   return rookAttacks(sq, 0);
+    case QUEEN:  return bishopAttacks(sq, 0) | rookAttacks(sq, 0);
+    case KING:   return kingAttacks[sq];
+    }
+    return 0;
+}
+
+int initCuckoo()
+{
+    for (int i = 0; i < CUCKOO_SIZE; ++i) {
+        cuckooKeys[i] = 0;
+        cuckooMoves[i] = 0;
+    }
+
+    int count = 0;
+    for (int pc = 0; pc < 12; ++pc) {
+        int type = pc % 6;
+        if (type == PAWN) continue; // Pawn moves are never reversible
+        for (int s1 = 0; s1 < 64; ++s1)
+            for (int s2 = s1 + 1; s2 < 64; ++s2) {
+                if (!(emptyBoardAttacks(type, s1) & squareBB(s2))) continue;
+
+                unsigned long long key = pieceKeys[pc][s1] ^ pieceKeys[pc][s2] ^ sideKey;
+                unsigned short move = (unsigned short)(s1 | (s2 << 6));
+                // Insert, evicting the occupant to its other slot until a slot is free
+                int slot = cuckooH1(key);
+                while (true) {
+                    std::swap(cuckooKeys[slot], key);
+                    std::swap(cuckooMoves[slot], move);
+                    if (move == 0) break;
+                    slot = slot == cuckooH1(key) ? cuckooH2(key) : cuckooH1(key);
+                }
+                ++count;
+            }
+    }
+    return count;
+}
@@ -0,0 +1,71 @@
+/**
+ * @file cuckoo.h
+ * @brief File declaration for the cuckoo table of reversible move keys (upcoming repetition detection).
+ * @version 0.1
+ * @date 2026-01-12
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+/**
+ * @brief Number of cuckoo slots (power of two, indexed by 13 key bits).
+ *
+ */
+const int CUCKOO_SIZE = 8192;
+
+/**
+ * @brief Number of reversible moves stored (N, B, R, Q, K of both colors between two squares).
+ *
+ */
+const int CUCKOO_MOVES = 3668;
+
+/**
+ * @brief Key of a reversible move: pieceKeys[pc][from] ^ pieceKeys[pc][to] ^ sideKey, 0 = empty slot.
+ *
+ */
+extern unsigned long long cuckooKeys[CUCKOO_SIZE];
+
+/**
+ * @brief Squares of the move stored in the same slot, from | (to << 6), from < to.
+ *
+ */
+extern unsigned short cuckooMoves[CUCKOO_SIZE];
+
+/**
+ * @brief First cuckoo slot of a move key.
+ *
+ * @param key Move key.
+ * @return Slot index.
+ */
+inline int cuckooH1(unsigned long long key) { return (int)(key & (CUCKOO_SIZE - 1)); }
+
+/**
+ * @brief Second cuckoo slot of a move key.
+ *
+ * @param key Move key.
+ * @return Slot index.
+ */
+inline int cuckooH2(unsigned long long key) { return (int)((key >> 16) & (CUCKOO_SIZE - 1)); }
+
+/**
+ * @brief Find a reversible move key.
+ *
+ * @param key XOR of two position keys.
+ * @return Slot holding @p key, -1 if the positions are not one reversible move apart.
+ */
+inline int cuckooFind(unsigned long long key) {
+    int slot = cuckooH1(key);
+    if (cuckooKeys[slot] == key) return slot;
+    slot = cuckooH2(key);
+    if (cuckooKeys[slot] == key) return slot;
+    return -1;
+}
+
+/**
+ * @brief Build the cuckoo table from pieceKeys and sideKey (called by initZobrist()).
+ *
+ * @return Number of moves inserted (CUCKOO_MOVES).
+ */
+int initCuckoo();
@@ -0,0 +1,255 @@
+/**
+ * @file history.h
+ * @brief File declaration for quiet move ordering tables (killers, history, countermoves, continuation history).
+ * @version 0.1
+ * @date 2026-01-12
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+#include "../moves.h"
+
+/**
+ * @brief Maximum search ply tracked by per-ply tables.
+ *
+ */
+const int MAX_PLY = 128;
+/**
+ * @brief Saturation limit of a history counter (gravity keeps |h| below it).
+ *
+ */
+const int HISTORY_MAX = 16384;
+/**
+ * @brief Number of piece indices (see getPieceIndex() in zobrist.h).
+ *
+ */
+const int PIECE_TYPES = 12;
+
+/**
+ * @brief Compare two moves by squares and promotion only.
+ *
+ * @details Piece pointers are ignored, so moves coming from different board copies
+ * (or from tables) still match the moves generated for the current board.
+ * @param a First move.
+ * @param b Second move.
+ * @return True if both describe the same move.
+ */
+inline bool sameMove(const Move& a, const Move& b) {
+    return a.from.row == b.from.row && a.from.col == b.from.col &&
+        a.to.row == b.to.row && a.to.col == b.to.col &&
+        a.promotion == b.promotion;
+}
+
+/**
+ * @brief Check whether move is quiet (no capture, no promotion).
+ *
+ * @param move Move to check.
+ * @return True for quiet moves.
+ */
+inline bool isQuiet(const Move& move) {
+    return move.pieceCaptured == nullptr && move.promotion == 0;
+}
+
+/**
+ * @brief Quiet move ordering tables.
+ *
+ * - killers: two quiet moves per ply that caused a beta cutoff in a sibling node,
+ * - butterfly: [color][from][to] counters, rewarded on cutoffs, penalized for quiets
+ *   tried before the cutoff move,
+ * - countermoves: the quiet refutation of a move, indexed by [piece][to] of that move,
+ * - continuation: counters indexed by (previous piece, previous to, piece, to), so the
+ *   score depends on the move pair and not only on the move itself.
+ *
+ * Piece indices follow getPieceIndex() (0..11), squares are row * 8 + col.
+ */
+class HistoryTables {
+public:
+    /**
+     * @brief Killer move slots, slot 0 is the most recent one.
+     *
+     */
+    Move killers[MAX_PLY][2];
+    /**
+     * @brief Butterfly history indexed by [color][fromSq][toSq].
+     *
+     */
+    int butterfly[2][64][64];
+    /**
+     * @brief Countermove table indexed by [previous piece][previous to-square].
+     *
+     */
+    Move countermoves[PIECE_TYPES][64];
+    /**
+     * @brief Continuation history, flattened [prevPiece][prevTo][piece][to].
+     *
+     * @details Kept on the heap (about 2.4 MB) so engines can live on the stack.
+     */
+    std::vector<int> continuation;
+
+    HistoryTables() : continuation(PIECE_TYPES * 64 * PIECE_TYPES * 64, 0) { clear(); }
+
+    /**
+     * @brief Reset all tables.
+     *
+     */
+    void clear() {
+        clearKillers();
+        for (auto& side : butterfly)
+            for (auto& from : side)
+                for (int& h : from) h = 0;
+        for (auto& piece : countermoves)
+            for (Move& m : piece) m = Move{ {-1,-1}, {-1,-1}, nullptr, nullptr };
+        std::fill(continuation.begin(), continuation.end(), 0);
+    }
+
+    /**
+     * @brief Reset killer slots (killers are only valid for one search).
+     *
+     */
+    void clearKillers() {
+        for (auto& slots : killers) {
+            slots[0] = Move{ {-1,-1}, {-1,-1}, nullptr, nullptr };
+            slots[1] = Move{ {-1,-1}, {-1,-1}, nullptr, nullptr };
+        }
+    }
+
+    /**
+     * @brief Age tables between searches.
+     *
+     * @details Halves every history counter so old statistics fade but still help
+     * the first iterations of the next search. Killers are cleared.
+     */
+    void age() {
+        clearKillers();
+        for (auto& side : butterfly)
+            for (auto& from : side)
+                for (int& h : from) h /= 2;
+        for (int& h : continuation) h /= 2;
+    }
+
+    /**
+     * @brief Store a quiet cutoff move as killer for @p ply.
+     *
+     * @param ply Distance from root.
+     * @param move Move that caused the cutoff.
+     */
+    void storeKiller(int ply, const Move& move) {
+        if (ply < 0 || ply >= MAX_PLY) return;
+        if (sameMove(killers[ply][0], move)) return;
+        killers[ply][1] = killers[ply][0];
+        killers[ply][0] = move;
+    }
+
+    /**
+     * @brief Get the killer slot holding @p move.
+     *
+     * @param ply Distance from root.
+     * @param move Move to look up.
+     * @return 0 or 1 for the matching slot, -1 if move is not a killer.
+     */
+    int killerSlot(int ply, const Move& move) const {
+        if (ply < 0 || ply >= MAX_PLY) return -1;
+        if (sameMove(killers[ply][0], move)) return 0;
+        if (sameMove(killers[ply][1], move)) return 1;
+        return -1;
+    }
+
+    /**
+     * @brief Get butterfly history score of a move.
+     *
+     * @param color 0 = White, 1 = Black.
+     * @param move Move to score.
+     * @return History counter.
+     */
+    int get(int color, const Move& move) const {
+        return butterfly[color][move.from.row * 8 + move.from.col][move.to.row * 8 + move.to.col];
+    }
+
+    /**
+     * @brief Add a bonus (or malus if negative) to a history counter.
+     *
+     * @details Uses the "gravity" formula h += bonus - h * |bonus| / HISTORY_MAX,
+     * so counters saturate smoothly instead of overflowing.
+     * @param color 0 = White, 1 = Black.
+     * @param move Move to update.
+     * @param bonus Signed bonus, typically depth * depth.
+     */
+    void update(int color, const Move& move, int bonus) {
+        int& h = butterfly[color][move.from.row * 8 + move.from.col][move.to.row * 8 + move.to.col];
+        applyGravity(h, bonus);
+    }
+
+    /**
+     * @brief Apply the gravity update to one counter.
+     *
+     * @param h Counter to update.
+     * @param bonus Signed bonus.
+     */
+    static void applyGravity(int& h, int bonus) {
+        if (bonus > HISTORY_MAX) bonus = HISTORY_MAX;
+        if (bonus < -HISTORY_MAX) bonus = -HISTORY_MAX;
+        h += bonus - h * std::abs(bonus) / HISTORY_MAX;
+    }
+
+    /**
+     * @brief Get the countermove stored for a previous move.
+     *
+     * @param prevPiece Piece index of the previous move (-1 if none).
+     * @param prevTo To-square of the previous move.
+     * @return Stored countermove (invalid squares if none).
+     */
+    const Move& counterMove(int prevPiece, int prevTo) const {
+        static const Move none{ {-1,-1}, {-1,-1}, nullptr, nullptr };
+        if (prevPiece < 0) return none;
+        return countermoves[prevPiece][prevTo];
+    }
+
+    /**
+     * @brief Remember @p move as the refutation of the previous move.
+     *
+     * @param prevPiece Piece index of the previous move (-1 if none).
+     * @param prevTo To-square of the previous move.
+     * @param move Quiet cutoff move.
+     */
+    void storeCounterMove(int prevPiece, int prevTo, const Move& move) {
+        if (prevPiece < 0) return;
+        countermoves[prevPiece][prevTo] = move;
+    }
+
+    /**
+     * @brief Get continuation history of a move pair.
+     *
+     * @param prevPiece Piece index of the earlier move (-1 if none).
+     * @param prevTo To-square of the earlier move.
+     * @param piece Piece index of the current move.
+     * @param to To-square of the current move.
+     * @return History counter, 0 if there is no earlier move.
+     */
+    int getContinuation(int prevPiece, int prevTo, int piece, int to) const {
+        if (prevPiece < 0) return 0;
+        return continuation[contIndex(prevPiece, prevTo, piece, to)];
+    }
+
+    /**
+     * @brief Add a bonus (or malus) to continuation history of a move pair.
+     *
+     * @param prevPiece Piece index of the earlier move (-1 if none).
+     * @param prevTo To-square of the earlier move.
+     * @param piece Piece index of the current move.
+     * @param to To-square of the current move.
+     * @param bonus Signed bonus.
+     */
+    void updateContinuation(int prevPiece, int prevTo, int piece, int to, int bonus) {
+        if (prevPiece < 0) return;
+        applyGravity(continuation[contIndex(prevPiece, prevTo, piece, to)], bonus);
+    }
+
+private:
+    static int contIndex(int prevPiece, int prevTo, int piece, int to) {
+        return ((prevPiece * 64 + prevTo) * PIECE_TYPES + piece) * 64 + to;
+    }
+};
@@ -0,0 +1,93 @@
+/**
+ * @file repetition.h
+ * @brief File declaration for the repetition key stack (game history + current search path).
+ * @version 0.1
+ * @date 2026-01-12
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+#include <algorithm>
+#include <vector>
+#include "../moves.h"
+#include "history.h"
+
+/**
+ * @brief Zobrist keys of the game history followed by the current search path.
+ *
+ * - Each entry keeps the halfmove clock of its position (plies since the last capture or pawn move).
+ * - A position can only repeat one with the same side to move, so the lookup
+ *   steps back 2 plies at a time and stops at the last irreversible move.
+ * - The top entry is always the position currently searched.
+ */
+struct RepetitionStack {
+    /**
+     * @brief Stack entry: position key and halfmove clock.
+     *
+     */
+    struct Entry {
+        unsigned long long key;
+        int clock;
+    };
+    std::vector<Entry> entries;
+
+    /**
+     * @brief Start a search from the game history.
+     *
+     * @param history Keys of the game so far, oldest first (cleared by the game
+     *                after irreversible moves, so entry i is i plies after one).
+     * @param rootKey Key of the root position, appended if the history does not end with it.
+     * @param rootClock Halfmove clock of the root position.
+     */
+    void reset(const std::vector<unsigned long long>& history, unsigned long long rootKey, int rootClock) {
+        entries.clear();
+        entries.reserve(history.size() + MAX_PLY + 2);
+        for (size_t i = 0; i < history.size(); ++i)
+            entries.push_back({ history[i], (int)i });
+        if (entries.empty() || entries.back().key != rootKey)
+            entries.push_back({ rootKey, (int)entries.size() });
+        entries.back().clock = std::min(entries.back().clock, rootClock);
+    }
+
+    /**
+     * @brief Enter a child position.
+     *
+     * @param key Key of the child position.
+     * @param clock Halfmove clock of the child position.
+     */
+    void push(unsigned long long key, int clock) {
+        entries.push_back({ key, clock });
+    }
+
+    /**
+     * @brief Leave the current position.
+     *
+     */
+    void pop() {
+        entries.pop_back();
+    }
+
+    /**
+     * @brief Check whether the position at @p index appeared before it with the same side to move.
+     *
+     * @param index Stack index of the position.
+     * @return True on a repetition within that position's halfmove window.
+     */
+    bool repeatedAt(int index) const {
+        int window = std::min(entries[index].clock, index);
+        for (int i = 4; i <= window; i += 2) // Same side to move, 2 plies back is at best a null move
+            if (entries[index - i].key == entries[index].key)
+                return true;
+        return false;
+    }
+
+    /**
+     * @brief Check whether the top position appeared before with the same side to move.
+     *
+     * @return True on a repetition within the current halfmove window.
+     */
+    bool repeated() const {
+        return !entries.empty() && repeatedAt((int)entries.size() - 1);
+    }
+};
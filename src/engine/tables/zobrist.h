@@ -10,6 +10,7 @@
 #pragma once
 #include <random>
 #include <vector>
+#include "cuckoo.h"
 
 // 12 Pieces = 6 white, 6 black * 64 pola
 // White: P=0, N=1, B=2, R=3, Q=4, K=5
@@ -33,6 +34,7 @@ inline void initZobrist() {
         }
     }
     sideKey = rng();
+    initCuckoo(); // Reversible move keys depend on the piece keys
 }
 
 // Mapping helper
@@ -0,0 +1,86 @@
+/**
+ * @file timeman.cpp
+ * @brief File implementation for the search time manager.
+ * @version 0.1
+ * @date 2026-01-12
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "timeman.h"
+#include "params.h"
+#include <algorithm>
+
+/// Current steady_clock time in nanoseconds.
+static long long nowNs()
+{
+    return (long long)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void TimeManager::start(int softMs, int hardMs)
+{
+    startNs.store(nowNs(), std::memory_order_relaxed);
+    softLimitMs = softMs;
+    hardLimitMs = std::max(softMs, hardMs);
+    adaptive = false;
+}
+
+/**
+ * @brief Allocate the limits from the game clock.
+ *
+ * @details The clock is split over the moves expected to remain (fewer as the
+ * game goes on), plus most of the increment. The hard limit allows a few times
+ * that, but never a large share of the clock.
+ * @param clockMs Remaining time of the side to move.
+ * @param incrementMs Time added after each move.
+ * @param moveNumber Full move number of the game.
+ */
+void TimeManager::startFromClock(int clockMs, int incrementMs, int moveNumber)
+{
+    startNs.store(nowNs(), std::memory_order_relaxed);
+    int available = std::max(clockMs - TM_OVERHEAD_MS, 1);
+    int movesToGo = std::clamp(TM_MOVES_TO_GO - moveNumber / 2, TM_MIN_MOVES_TO_GO, TM_MOVES_TO_GO);
+
+    optimumMs = std::max(available / movesToGo + incrementMs * 3 / 4, 1);
+    hardLimitMs = std::min(optimumMs * TM_HARD_FACTOR, available * TM_MAX_CLOCK_PERCENT / 100);
+    hardLimitMs = std::max(hardLimitMs, 1);
+    optimumMs = std::min(optimumMs, hardLimitMs);
+    softLimitMs = optimumMs;
+    stableIterations = 0;
+    adaptive = true;
+}
+
+/**
+ * @brief Rescale the soft limit from best move stability and score drops.
+ *
+ * @details A best move that survived several iterations is unlikely to change,
+ * the soft limit shrinks down to half the optimum. A new best move or a falling
+ * score means the position is not understood yet, the limit grows (never past
+ * the hard limit).
+ * @param bestMoveChanged True if the iteration changed the best move.
+ * @param scoreDrop Previous iteration score minus this one.
+ */
+void TimeManager::onIteration(bool bestMoveChanged, int scoreDrop)
+{
+    if (!adaptive) return;
+    stableIterations = bestMoveChanged ? 0 : stableIterations + 1;
+
+    // 0 stable iterations: 1.3x, then 0.15 less per iteration down to 0.5x
+    double stability = std::max(0.5, 1.3 - 0.15 * stableIterations);
+    // Up to twice the time for a drop of TM_SCORE_DROP centipawns or more
+    double drop = 1.0 + std::clamp(scoreDrop, 0, TM_SCORE_DROP) / (double)TM_SCORE_DROP;
+
+    softLimitMs = std::min((int)(optimumMs * stability * drop), hardLimitMs);
+}
+
+long TimeManager::elapsedMs() const
+{
+    return (long)((nowNs() - startNs.load(std::memory_order_relaxed)) / 1000000);
+}
+
+void TimeManager::ponderhit()
+{
+    // Time spent pondering was the opponent's, the budget starts now
+    startNs.store(nowNs(), std::memory_order_relaxed);
+    infinite.store(false, std::memory_order_release); // A thread that sees the limits active also sees the new start
+}
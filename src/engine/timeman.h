@@ -0,0 +1,106 @@
+/**
+ * @file timeman.h
+ * @brief File declaration for the search time manager (soft and hard limits).
+ * @version 0.1
+ * @date 2026-01-12
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+#include <atomic>
+#include <chrono>
+
+/**
+ * @brief Wall clock budget of one search.
+ *
+ * - soft limit: no new iteration is started once it has passed,
+ * - hard limit: the running iteration is aborted (polled inside the search).
+ *
+ * With a game clock the limits are allocated from the remaining time and the
+ * move number, and the soft limit follows the search: it shrinks while the best
+ * move stays the same and grows when the best move changes or the score drops.
+ *
+ * While pondering the limits are suspended; ponderhit() restarts the clock
+ * from another thread and puts them into effect.
+ */
+class TimeManager {
+public:
+    /**
+     * @brief Start the clock.
+     *
+     * @param softMs Soft limit in milliseconds.
+     * @param hardMs Hard limit in milliseconds, raised to @p softMs if lower.
+     */
+    void start(int softMs, int hardMs);
+
+    /**
+     * @brief Start the clock with limits allocated from the game clock.
+     *
+     * @param clockMs Remaining time of the side to move.
+     * @param incrementMs Time added after each move.
+     * @param moveNumber Full move number of the game (1 = first move).
+     */
+    void startFromClock(int clockMs, int incrementMs, int moveNumber);
+
+    /**
+     * @brief Rescale the soft limit after a completed iteration (game clock only).
+     *
+     * @param bestMoveChanged True if the iteration changed the best move.
+     * @param scoreDrop Score of the previous iteration minus this one (positive = worse).
+     */
+    void onIteration(bool bestMoveChanged, int scoreDrop);
+
+    /**
+     * @brief Milliseconds since start().
+     *
+     * @return Elapsed wall time.
+     */
+    long elapsedMs() const;
+
+    /**
+     * @brief Check whether the soft limit has passed.
+     *
+     * @return True if no new iteration should start.
+     */
+    bool softExpired() const { return !infinite.load(std::memory_order_acquire) && elapsedMs() >= softLimitMs; }
+
+    /**
+     * @brief Check whether the hard limit has passed.
+     *
+     * @return True if the search must stop now.
+     */
+    bool hardExpired() const { return !infinite.load(std::memory_order_acquire) && elapsedMs() >= hardLimitMs; }
+
+    /**
+     * @brief Suspend the limits (pondering) or put them into effect.
+     *
+     * @param enabled True to search until stopped.
+     */
+    void setInfinite(bool enabled) { infinite.store(enabled, std::memory_order_release); }
+
+    /**
+     * @brief The pondered move was played: restart the clock and apply the limits.
+     *
+     * @details Safe to call while the search runs on other threads.
+     */
+    void ponderhit();
+
+    /**
+     * @brief Soft limit in milliseconds.
+     *
+     */
+    int softLimitMs = 0;
+    /**
+     * @brief Hard limit in milliseconds.
+     *
+     */
+    int hardLimitMs = 0;
+
+private:
+    std::atomic<long long> startNs{ 0 };     // steady_clock time of start() / ponderhit()
+    std::atomic<bool> infinite{ false };     // Pondering, limits suspended; release/acquire publishes startNs
+    bool adaptive = false;   // Limits come from the game clock
+    int optimumMs = 0;       // Soft limit before stability scaling
+    int stableIterations = 0; // Completed iterations since the best move last changed
+};
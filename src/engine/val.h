@@ -47,6 +47,18 @@ static inline int pieceValFromSymbol(char symbol)
  */
 static const int INF = std::numeric_limits<int>::max();
 
+/**
+ * @brief Score of being checkmated (negated), mate in N is MATE_SCORE - N.
+ *
+ * @details Kept below 32767 so scores fit the 16-bit TT score field.
+ */
+static const int MATE_SCORE = 32000;
+/**
+ * @brief Scores beyond this bound (in absolute value) are mate scores.
+ *
+ */
+static const int MATE_BOUND = MATE_SCORE - 1000;
+
 //static const int depth = 6; // Fixed search depth, might change later
 
 inline static const int pawnPST[8][8] = {
@@ -0,0 +1,245 @@
+/**
+ * @file worker.cpp
+ * @brief File implementation for the persistent engine worker thread.
+ * @version 0.1
+ * @date 2026-01-12
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "worker.h"
+#include "../Pawn.h"
+#include "../Rook.h"
+#include "../kNight.h"
+#include "../Bishop.h"
+#include "../Queen.h"
+#include "../King.h"
+#include "tables/zobrist.h"
+#include <utility>
+
+PositionSnapshot PositionSnapshot::of(const Board& board)
+{
+    PositionSnapshot s;
+    for (int r = 0; r < 8; ++r)
+        for (int c = 0; c < 8; ++c) {
+            Piece* p = board.squares[r][c];
+            s.squares[r * 8 + c] = p ? (signed char)getPieceIndex(p->getSymbol(), p->getColor()) : -1;
+        }
+    s.sideToMove = board.sideToMove;
+    s.halfmoveClock = board.halfmoveClock;
+    s.history = board.positionHistory;
+    return s;
+}
+
+void PositionSnapshot::apply(Board& board) const
+{
+    static const char symbols[] = "PNBRQK";
+    board = Board(); // Board owns its pieces, assignment frees the previous ones
+    for (int r = 0; r < 8; ++r)
+        for (int c = 0; c < 8; ++c) {
+            int idx = squares[r * 8 + c];
+            if (idx < 0) continue;
+            int color = idx / 6;
+            char sym = symbols[idx % 6];
+            Position pos{ r, c };
+            switch (sym) {
+            case 'P': board.squares[r][c] = new Pawn(color, sym, pos); break;
+            case 'N': board.squares[r][c] = new Knight(color, sym, pos); break;
+            case 'B': board.squares[r][c] = new Bishop(color, sym, pos); break;
+            case 'R': board.squares[r][c] = new Rook(color, sym, pos); break;
+            case 'Q': board.squares[r][c] = new Queen(color, sym, pos); break;
+            case 'K': board.squares[r][c] = new King(color, sym, pos); break;
+            }
+        }
+    board.sideToMove = sideToMove;
+    board.halfmoveClock = halfmoveClock;
+    board.positionHistory = history;
+    board.computeZobristHash();
+}
+
+EngineWorker::EngineWorker(int threads)
+    : pool(threads)
+{
+    thread = std::thread(&EngineWorker::loop, this);
+}
+
+EngineWorker::~EngineWorker()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        cancelledUpTo = nextId - 1;
+        if (runningId) pool.stopSearch();
+        Command quit;
+        quit.type = CommandType::Quit;
+        queue.push_back(std::move(quit));
+    }
+    wake.notify_one();
+    thread.join();
+}
+
+unsigned EngineWorker::enqueue(Command command)
+{
+    unsigned id;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        id = command.id = nextId++;
+        queue.push_back(std::move(command));
+    }
+    wake.notify_one();
+    return id;
+}
+
+unsigned EngineWorker::search(const PositionSnapshot& position, const SearchLimits& limits)
+{
+    Command command;
+    command.position = position;
+    command.limits = limits;
+    command.limits.ponder = false;
+    return enqueue(std::move(command));
+}
+
+unsigned EngineWorker::ponder(const PositionSnapshot& position, const SearchLimits& limits)
+{
+    Command command;
+    command.position = position;
+    command.limits = limits;
+    command.limits.ponder = true;
+    unsigned id = enqueue(std::move(command));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    lastPonderId = id;
+    hasLastPonder = false;
+    return id;
+}
+
+/**
+ * @brief Convert the last ponder search into the real search.
+ *
+ * @details Depending on how far it got: a running ponder search gets its clock
+ * started, a queued one loses its ponder flag, a finished one is delivered as is.
+ * @return False if the ponder search was cancelled or never queued.
+ */
+bool EngineWorker::ponderhit()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!lastPonderId || lastPonderId <= cancelledUpTo) return false;
+
+    if (runningId == lastPonderId && runningPonder) {
+        pool.ponderhit();
+        runningPonder = false;
+        return true;
+    }
+    for (auto& command : queue)
+        if (command.id == lastPonderId) {
+            command.limits.ponder = false;
+            return true;
+        }
+    if (hasLastPonder && lastPonder.id == lastPonderId) {
+        hasLastPonder = false;
+        deliverLocked(lastPonder);
+        if (onResult) onResult();
+        return true;
+    }
+    return false;
+}
+
+void EngineWorker::stop()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    cancelledUpTo = nextId - 1;
+    hasLastPonder = false;
+    if (runningId) pool.stopSearch(); // Armed under this lock, cannot be cleared afterwards
+}
+
+void EngineWorker::newGame()
+{
+    Command command;
+    command.type = CommandType::NewGame;
+    enqueue(std::move(command));
+}
+
+bool EngineWorker::tryTakeResult(EngineResult& out)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (results.empty()) return false;
+    out = results.front();
+    results.erase(results.begin());
+    return true;
+}
+
+EngineResult EngineWorker::waitResult()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return !results.empty(); });
+    EngineResult out = results.front();
+    results.erase(results.begin());
+    return out;
+}
+
+void EngineWorker::deliverLocked(const EngineResult& result)
+{
+    results.push_back(result);
+    done.notify_all();
+}
+
+/**
+ * @brief Worker thread: run commands in order until Quit.
+ *
+ * @details Searches are armed (SearchPool::start()) under the mutex, so stop()
+ * and ponderhit() always see either a queued command or an armed pool.
+ */
+void EngineWorker::loop()
+{
+    while (true) {
+        Command command;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return !queue.empty(); });
+            command = std::move(queue.front());
+            queue.pop_front();
+
+            if (command.type == CommandType::Quit) return;
+            if (command.type == CommandType::Search) {
+                if (command.id <= cancelledUpTo) continue;
+                runningId = command.id;
+                runningPonder = command.limits.ponder;
+                pool.start(command.limits);
+            }
+        }
+
+        if (command.type == CommandType::NewGame) {
+            pool.clearTT();
+            continue;
+        }
+
+        command.position.apply(board);
+        EngineResult result;
+        result.id = command.id;
+        result.search = pool.run(board, command.position.sideToMove, command.limits);
+
+        // Pointers refer to the worker's board, hand over squares only
+        Move& m = result.search.bestMove;
+        if (!m.pieceMoved) m.from = m.to = { -1, -1 };
+        m.pieceMoved = m.pieceCaptured = nullptr;
+        for (auto& line : result.search.lines)
+            line.move.pieceMoved = line.move.pieceCaptured = nullptr;
+
+        bool delivered = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (runningPonder) {
+                if (command.id > cancelledUpTo) {
+                    lastPonder = result; // Kept in case the hit comes after the search finished
+                    hasLastPonder = true;
+                }
+            }
+            else {
+                deliverLocked(result);
+                delivered = true;
+            }
+            runningId = 0;
+            runningPonder = false;
+        }
+        if (delivered && onResult) onResult();
+    }
+}
@@ -0,0 +1,176 @@
+/**
+ * @file worker.h
+ * @brief File declaration for the persistent engine worker thread (command queue, position snapshots).
+ * @version 0.1
+ * @date 2026-01-12
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../Board.h"
+#include "search.h"
+
+/**
+ * @brief Compact copy of a game position, cheap to hand over to another thread.
+ *
+ */
+struct PositionSnapshot {
+    signed char squares[64] = {};           // getPieceIndex() of the piece on row * 8 + col, -1 = empty
+    int sideToMove = 0;                     // 0 = White, 1 = Black
+    int halfmoveClock = 0;
+    std::vector<unsigned long long> history; // Board::positionHistory
+
+    /**
+     * @brief Take a snapshot of a board.
+     *
+     * @param board Board state.
+     * @return Snapshot of the pieces, side to move, halfmove clock and history.
+     */
+    static PositionSnapshot of(const Board& board);
+
+    /**
+     * @brief Set up @p board to the snapshot (pieces, hash, material signature).
+     *
+     * @param board Board to overwrite, its pieces are deleted.
+     */
+    void apply(Board& board) const;
+};
+
+/**
+ * @brief Result delivered by the worker.
+ *
+ */
+struct EngineResult {
+    SearchResult search; // Moves hold squares only, bestMove.from.row == -1 if there is no legal move
+    unsigned id = 0;     // Id returned by search() / ponder()
+};
+
+/**
+ * @brief Long-lived engine thread fed through a command queue.
+ *
+ * - search / ponder: search a position snapshot, the worker owns the board and the SearchPool,
+ * - stop: cancel queued searches and stop the running one,
+ * - ponderhit: turn the running (or queued, or finished) ponder search into the real one,
+ * - newGame: clear the TT between games, in order with the searches.
+ *
+ * Results of searches (and of ponder searches after a ponder hit) are kept for
+ * tryTakeResult() / waitResult(); ponder results without a hit are dropped.
+ */
+class EngineWorker {
+public:
+    /**
+     * @brief Start the worker thread.
+     *
+     * @param threads Number of search threads of its SearchPool.
+     */
+    explicit EngineWorker(int threads = 1);
+
+    /**
+     * @brief Stop the running search and join the worker thread.
+     */
+    ~EngineWorker();
+
+    EngineWorker(const EngineWorker&) = delete;
+    EngineWorker& operator=(const EngineWorker&) = delete;
+
+    /**
+     * @brief Queue a search.
+     *
+     * @param position Position to search, the side to move is the one searched.
+     * @param limits Depth and time limits.
+     * @return Id of the result.
+     */
+    unsigned search(const PositionSnapshot& position, const SearchLimits& limits);
+
+    /**
+     * @brief Queue a ponder search (time limits suspended until ponderhit()).
+     *
+     * @param position Position after the expected reply (or the current one to ponder it as a whole).
+     * @param limits Limits that apply after a ponder hit.
+     * @return Id of the result delivered after a ponder hit.
+     */
+    unsigned ponder(const PositionSnapshot& position, const SearchLimits& limits);
+
+    /**
+     * @brief The expected reply was played: the last ponder search becomes the real search.
+     *
+     * @return False if there is no ponder search to convert (queue a search instead).
+     */
+    bool ponderhit();
+
+    /**
+     * @brief Cancel queued searches and stop the running one.
+     *
+     * @details A running search that is not pondering still delivers its best move.
+     */
+    void stop();
+
+    /**
+     * @brief Queue clearing the TT for a new game.
+     */
+    void newGame();
+
+    /**
+     * @brief Take the delivered result, if any (non-blocking, for the GUI loop).
+     *
+     * @param out Receives the result.
+     * @return True if a result was taken.
+     */
+    bool tryTakeResult(EngineResult& out);
+
+    /**
+     * @brief Block until a result is delivered and take it.
+     *
+     * @return The result.
+     */
+    EngineResult waitResult();
+
+    /**
+     * @brief Called on the worker thread whenever a result is delivered (e.g. to wake up a GUI).
+     *
+     */
+    std::function<void()> onResult;
+
+    /**
+     * @brief Live progress of the running search (lock-free, for the GUI loop).
+     *
+     * @return Progress of the worker's SearchPool.
+     */
+    const SearchProgress& progress() const { return pool.progress(); }
+
+private:
+    enum class CommandType { Search, NewGame, Quit };
+    struct Command {
+        CommandType type = CommandType::Search;
+        unsigned id = 0;
+        PositionSnapshot position;
+        SearchLimits limits;
+    };
+
+    void loop();
+    unsigned enqueue(Command command);
+    void deliverLocked(const EngineResult& result);
+
+    SearchPool pool;
+    Board board;                           // Worker's own board, set up from snapshots
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable wake;          // Commands queued
+    std::condition_variable done;          // Result delivered
+    std::deque<Command> queue;
+    unsigned nextId = 1;
+    unsigned cancelledUpTo = 0;            // Queued searches with id <= this are skipped
+    unsigned runningId = 0;                // Search in progress, 0 = none
+    bool runningPonder = false;            // Search in progress is a ponder search without a hit
+    std::vector<EngineResult> results;     // Delivered, not taken yet
+    unsigned lastPonderId = 0;             // Most recent ponder() id
+    EngineResult lastPonder;               // Finished ponder search, kept for a late ponder hit
+    bool hasLastPonder = false;
+};
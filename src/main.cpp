@@ -21,31 +21,42 @@
 #include "Queen.h"
 #include "King.h"
 #include "engine/engine.h"
+#include "engine/search.h"
+#include "engine/worker.h"
+#include "engine/resumable.h"
 #include "engine/val.h"
 #include "engine/logger/logger.h"
 #include <string>
-#include <future>
+#include <memory>
+#include <thread>
+#include <algorithm>
 #include "engine/tables/zobrist.h"
 #include "engine/tables/TT.h"
 
 using namespace std;
 
-/**
- * @brief Perform t t.
- *
- * @details Implements the behavior implied by the function name.
- * @return Result of the operation.
- */
-TranspositionTable TT(64);
 // Global settings
 int difficultyLevel = 2; // 1-Easy, 2-Medium, 3-Hard
 int timeLimitMinutes = 10; // Default 10 minutes
+int hashSizeMB = 64; // Transposition table size
 
 const int TILE_SIZE = 80;
 const int BOARD_SIZE = 8;
 const int SIDEBAR_WIDTH = 260;
+// Search time per frame of the cooperative (single-threaded) engine, in ms
+const int COOPERATIVE_FRAME_MS = 12;
+// Easy mode plays one of the best EASY_MULTI_PV lines, at most EASY_MAX_LOSS centipawns worse than the best
+const int EASY_MULTI_PV = 4;
+const int EASY_MAX_LOSS = 150;
 
 Engine engine;
+// Search threads (Lazy SMP), main search thread included
+int engineThreads = std::max(1u, std::thread::hardware_concurrency());
+// Engine thread, created once the number of search threads is known
+std::unique_ptr<EngineWorker> worker;
+// Cooperative mode: the engine searches in slices on the GUI thread instead (single-core machines)
+bool cooperative = std::thread::hardware_concurrency() <= 1;
+ResumableSearch cooperativeSearch;
 // Helper function to reset board pieces
 /**
  * @brief Set up pieces.
@@ -92,99 +103,125 @@ string formatTime(float timeInSeconds) {
     ss << setfill('0') << setw(2) << minutes << ":" << setw(2) << seconds;
     return ss.str();
 }
+
+/**
+* @brief Sidebar lines of the live search progress.
+*
+* @param info Progress snapshot of the engine.
+* @return Depth, score (White's point of view), nodes, speed, hash usage and the start of the PV.
+*/
+static string formatProgress(const SearchInfo& info) {
+    if (info.depth == 0 && info.nodes == 0) return "";
+    stringstream ss;
+    int score = info.color == 0 ? info.score : -info.score;
+    ss << "Glebokosc " << info.depth << "  Ocena ";
+    if (std::abs(score) > MATE_BOUND)
+        ss << (score > 0 ? "M" : "-M") << (MATE_SCORE - std::abs(score) + 1) / 2;
+    else
+        ss << (score >= 0 ? "+" : "-") << std::abs(score) / 100 << "." << setfill('0') << setw(2) << std::abs(score) % 100;
+
+    ss << "\nWezly ";
+    if (info.nodes >= 1000000) ss << info.nodes / 1000000 << "." << (info.nodes / 100000) % 10 << "M";
+    else ss << info.nodes / 1000 << "k";
+    ss << "  " << info.nps / 1000 << " kN/s  Hash " << info.hashfull / 10 << "%";
+
+    ss << "\nPV:";
+    for (int i = 0; i < info.pvLength && i < 6; ++i) {
+        int from = info.pv[i] & 63, to = info.pv[i] >> 6;
+        ss << " " << (char)('a' + from % 8) << (char)('1' + from / 8) << (char)('a' + to % 8) << (char)('1' + to / 8);
+    }
+    return ss.str();
+}
 /**
-* @brief Perform run engine async.
+* @brief Play a move on the game board.
 *
-* @details Implements the behavior implied by the function name.
-* @param boardCopy Board state to operate on.
-* @param difficultyLevel Parameter.
-* @return Result of the operation.
+* @details Deletes a captured piece, promotes pawns to a queen and updates the
+* halfmove clock, side to move, Zobrist key and position history.
+* @param board Board state to operate on.
+* @param from Starting square.
+* @param to Target square.
+* @param color Side making the move, 0 = White, 1 = Black.
 */
-Move runEngineAsync(Board boardCopy, int difficultyLevel) {
-    int maxDepthAllowed = 64;
-    int timeLimitMs = 4000;
+static void playMove(Board& board, Position from, Position to, int color) {
+    Piece* piece = board.getPieceAt(from);
+    Piece* captured = board.getPieceAt(to);
+    if (!piece) return;
+    bool irreversible = captured || piece->getSymbol() == 'P';
+    bool promotes = piece->getSymbol() == 'P' && (to.row == 0 || to.row == 7);
+
+    board.movePiece(from, to, piece);
+    if (captured) delete captured;
+    if (promotes) board.promotePawn(board, to, 'Q', color);
+
+    // Earlier positions cannot repeat after a capture or pawn move
+    if (irreversible) board.positionHistory.clear();
+    board.halfmoveClock = irreversible ? 0 : board.halfmoveClock + 1;
+    board.sideToMove = 1 - color;
+    board.computeZobristHash();
+    board.positionHistory.push_back(board.zobristKey);
+}
 
+/**
+* @brief Expected reply of the side to move (best move stored in the TT).
+*
+* @param board Board state to operate on.
+* @return Legal move from the TT, pieceMoved == nullptr if none is known.
+*/
+static Move expectedReply(Board& board) {
+    Move none{ {-1,-1}, {-1,-1}, nullptr, nullptr };
+    int score = 0;
+    Move ttMove = none;
+    TT.probe(board.zobristKey, 0, -INF, INF, score, ttMove);
+    if (ttMove.from.row < 0) return none;
+    for (const Move& m : engine.legalMoves(board, board.sideToMove))
+        if (sameMove(m, ttMove)) return m;
+    return none;
+}
+
+/**
+* @brief Search limits of a difficulty level.
+*
+* @param difficultyLevel 1 = Easy, 2 = Medium, 3 = Hard.
+* @param clockMs Remaining game clock of the engine in milliseconds.
+* @param moveNumber Full move number of the game.
+* @return Depth and time limits.
+*/
+static SearchLimits limitsFor(int difficultyLevel, int clockMs, int moveNumber) {
+    SearchLimits limits;
     switch (difficultyLevel) {
-    case 1: // Easy
-        maxDepthAllowed = 2;
-        timeLimitMs = 10;
+    case 1: // Easy: ranked alternatives for pickEasyMove()
+        limits.maxDepth = 2;
+        limits.timeLimitMs = 10;
+        limits.hardLimitMs = 20;
+        limits.multiPV = EASY_MULTI_PV;
         break;
     case 2: // Medium
-        maxDepthAllowed = 4;
-        timeLimitMs = 350;
+        limits.maxDepth = 4;
+        limits.timeLimitMs = 200;
+        limits.hardLimitMs = 350;
         break;
-    case 3: // Hard
-        maxDepthAllowed = 64;
-        timeLimitMs = 2000;
+    case 3: // Hard: time allocated from the game clock
+        limits.maxDepth = 64;
+        limits.clockMs = clockMs;
+        limits.moveNumber = moveNumber;
         break;
     }
-    int aiSide = -1; // AI is playing black
-
-    auto moves = engine.legalMoves(boardCopy, engine.to01(aiSide));
-    std::string msg = "AI moves generated: " + std::to_string(moves.size());
-    LOG(msg);
-
-    if (moves.empty()) {
-		// If no moves available, return an invalid move
-        return Move{ {-1,-1}, {-1,-1}, nullptr, nullptr };
-    }
-
-    engine.orderMoves(moves);
-    sf::Clock clock;
-    Move bestMoveOfAll = moves[0];
-    bool timeUp = false;
-
-    for (int currentDepth = 1; currentDepth <= maxDepthAllowed; ++currentDepth) {
-        int alpha = -INF;
-        int beta = INF;
-        Move bestMoveThisDepth = moves[0];
-        int bestScoreThisDepth = -1000000;
-
-		// Primitive sorting: move best move from previous depth to front
-        for (int i = 0; i < moves.size(); ++i) {
-            if (moves[i].from.row == bestMoveOfAll.from.row &&
-                moves[i].from.col == bestMoveOfAll.from.col &&
-                moves[i].to.row == bestMoveOfAll.to.row &&
-                moves[i].to.col == bestMoveOfAll.to.col) {
-                std::swap(moves[0], moves[i]);
-                break;
-            }
-        }
-
-        for (auto& move : moves) {
-            if (clock.getElapsedTime().asMilliseconds() > timeLimitMs) {
-                timeUp = true;
-                break;
-            }
-            using Undo = Engine::Undo;
-            Undo undo;
- 
-            engine.applyMove(boardCopy, move, undo);
-            int score = -engine.negamax(boardCopy, currentDepth - 1, -beta, -alpha, -aiSide);
-            engine.undoMove(boardCopy, move, undo);
-
-            if (score > bestScoreThisDepth) {
-                bestScoreThisDepth = score;
-                bestMoveThisDepth = move;
-            }
-            if (score > alpha) alpha = score;
-        }
-        if (timeUp) break;
-        bestMoveOfAll = bestMoveThisDepth;
-
-        // Easy mode blunder simulation
-        if (difficultyLevel == 1 && moves.size() > 1) {
-            if (rand() % 2 == 0) {
-                int randomIdx = rand() % moves.size();
-                bestMoveOfAll = moves[randomIdx];
-				LOG("AI on Easy Mode made a blunder!");
-            }
-        }
+    return limits;
+}
 
-        if (bestScoreThisDepth > 90000) break;
-        if (currentDepth >= maxDepthAllowed) break;
-    }
-    return bestMoveOfAll;
+/**
+* @brief Strength-limited move choice of Easy mode.
+*
+* @param result Search result with MultiPV lines.
+* @return Random line at most EASY_MAX_LOSS worse than the best one, never one that walks into a mate.
+*/
+static Move pickEasyMove(const SearchResult& result) {
+    std::vector<const RootLine*> candidates;
+    for (const auto& line : result.lines)
+        if (line.score >= result.lines[0].score - EASY_MAX_LOSS && line.score > -MATE_BOUND)
+            candidates.push_back(&line);
+    if (candidates.empty()) return result.bestMove;
+    return candidates[rand() % candidates.size()]->move;
 }
 
 /**
@@ -193,10 +230,30 @@ Move runEngineAsync(Board boardCopy, int difficultyLevel) {
  * @details Implements the behavior implied by the function name.
  * @return Integer result.
  */
-int main() {
-    std::future<Move> engineFuture;
+int main(int argc, char* argv[]) {
     bool isEngineThinking = false;
+    // Pondering: search during the human's turn, on the expected reply if one is known
+    bool isPondering = false;
+    Move ponderMove{ {-1,-1}, {-1,-1}, nullptr, nullptr }; // pieceMoved == nullptr: whole position
+    auto stopPondering = [&]() {
+        if (!isPondering) return;
+        worker->stop();
+        isPondering = false;
+    };
+    // Optional "--threads N" overrides the number of search threads
+    // Optional "--hash MB" overrides the transposition table size
+    // Optional "--cooperative" searches on the GUI thread, without an engine thread
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--cooperative") cooperative = true;
+        if (i + 1 == argc) break;
+        if (std::string(argv[i]) == "--threads") engineThreads = std::max(1, std::atoi(argv[i + 1]));
+        if (std::string(argv[i]) == "--hash") hashSizeMB = std::max(1, std::atoi(argv[i + 1]));
+    }
+    if ((size_t)hashSizeMB != TT.sizeMB()) TT.resize(hashSizeMB);
+    LOG("TT: " + std::to_string(TT.sizeMB()) + " MB, " + std::to_string(TT.size) + " clusters, " + TT.hugePageStatus());
     initZobrist();
+    if (!cooperative) worker = std::make_unique<EngineWorker>(engineThreads);
+    else LOG("Cooperative search on the GUI thread");
     std::srand((unsigned)std::time(nullptr));
 
     // Konfiguracja czasu (startowa)
@@ -245,6 +302,11 @@ int main() {
     labelWhite.setFont(font); labelWhite.setString("GRACZ BIALY"); labelWhite.setCharacterSize(16); labelWhite.setFillColor(sf::Color(180, 180, 180));
     labelWhite.setPosition((float)(BOARD_SIZE * TILE_SIZE + 25), (float)(BOARD_SIZE * TILE_SIZE - 135));
 
+    // Live search progress, between the black clock and the controls
+    sf::Text progressText;
+    progressText.setFont(font); progressText.setCharacterSize(11); progressText.setFillColor(sf::Color(180, 180, 180));
+    progressText.setPosition((float)(BOARD_SIZE * TILE_SIZE + 20), 114.f);
+
     // --- BUTTONS SETUP ---
     float btnX = BOARD_SIZE * TILE_SIZE + 20;
     float btnY = 160; // Start Y position for controls
@@ -321,6 +383,7 @@ int main() {
     board->positionHistory.push_back(board->zobristKey);
 
     int currentPlayer = 0;
+    int moveNumber = 1; // Full moves, advanced after each engine (Black) move
     Position selected = { -1, -1 };
     Piece* selectedPiece = nullptr;
     bool gameOver = false;
@@ -361,6 +424,7 @@ int main() {
             if (timeWhite <= 0) { gameOver = true; statusText.setString("KONIEC CZASU!\nWygrywaja CZARNE"); timeWhite = 0; }
             if (timeBlack <= 0) { gameOver = true; statusText.setString("KONIEC CZASU!\nWygrywaja BIALE"); timeBlack = 0; }
         }
+        if (gameOver) stopPondering();
 
         sf::Event event;
         while (window.pollEvent(event)) {
@@ -397,14 +461,18 @@ int main() {
                 // --- HANDLE RESET LOGIC ---
                 if (resetNeeded && !isEngineThinking) {
                     LOG("Resetting Game...");
+                    stopPondering();
                     delete board;
                     board = new Board();
                     setupPieces(*board);
                     board->computeZobristHash();
                     board->positionHistory.clear();
                     board->positionHistory.push_back(board->zobristKey);
+                    if (worker) worker->newGame();
+                    else TT.clear();
 
                     currentPlayer = 0;
+                    moveNumber = 1;
                     selected = { -1, -1 };
                     selectedPiece = nullptr;
                     gameOver = false;
@@ -473,14 +541,7 @@ int main() {
 
                             if (isLegal) {
 
-                                Piece* captured = board->getPieceAt(clickedPos);
-                                board->movePiece(selected, clickedPos, selectedPiece);
-                                if (captured) delete captured;
-
-                                if (selectedPiece->getSymbol() == 'P' && (clickedPos.row == 0 || clickedPos.row == 7)) {
-                                    board->promotePawn(*board, clickedPos, 'Q', currentPlayer);
-                                }
-
+                                playMove(*board, selected, clickedPos, currentPlayer);
                                 currentPlayer = 1 - currentPlayer;
 
                                 if (board->isKingInCheck(currentPlayer)) {
@@ -492,6 +553,19 @@ int main() {
                                 }
                                 else statusText.setString("");
 
+                                if (isPondering) {
+                                    bool hit = ponderMove.pieceMoved && !gameOver
+                                        && ponderMove.from.row == selected.row && ponderMove.from.col == selected.col
+                                        && ponderMove.to.row == clickedPos.row && ponderMove.to.col == clickedPos.col;
+                                    if (hit && worker->ponderhit()) {
+                                        // Ponder hit: the ponder search becomes the real one, its clock starts now
+                                        isPondering = false;
+                                        isEngineThinking = true;
+                                        LOG("Ponder hit");
+                                    }
+                                    else stopPondering();
+                                }
+
                                 selectedPiece = nullptr;
                                 selected = { -1, -1 };
                                 validMoves.clear();
@@ -582,6 +656,12 @@ int main() {
         centerText(statusText, (float)(BOARD_SIZE * TILE_SIZE + SIDEBAR_WIDTH / 2.0f), (float)(BOARD_SIZE * TILE_SIZE - 200));
         window.draw(statusText);
 
+        // Read without blocking, the engine keeps searching meanwhile
+        if (!gameOver) {
+            progressText.setString(formatProgress(worker ? worker->progress().read() : cooperativeSearch.progress().read()));
+            window.draw(progressText);
+        }
+
         // Draw Buttons
         // Difficulty
         window.draw(diffLabel);
@@ -603,13 +683,43 @@ int main() {
         // AI Logic Handling
         if (currentPlayer == 1)
         {
+            SearchLimits limits = limitsFor(difficultyLevel, (int)(timeBlack * 1000.0f), moveNumber);
             if (!isEngineThinking) {
                 isEngineThinking = true;
-                engineFuture = std::async(std::launch::async, runEngineAsync, *board, difficultyLevel);
+                if (worker) worker->search(PositionSnapshot::of(*board), limits);
+                else cooperativeSearch.start(*board, 1, limits);
+            }
+            EngineResult result;
+            bool resultReady = false;
+            if (worker) resultReady = worker->tryTakeResult(result);
+            else if (isEngineThinking) {
+                // Search until this frame's budget is used, the next frame resumes it
+                sf::Clock sliceClock;
+                while (!cooperativeSearch.step() && sliceClock.getElapsedTime().asMilliseconds() < COOPERATIVE_FRAME_MS) {}
+                if (cooperativeSearch.finished()) {
+                    result.search = cooperativeSearch.result();
+                    resultReady = true;
+                }
             }
-            if (engineFuture.valid() && engineFuture.wait_for(std::chrono::milliseconds(0)) == std::future_status::ready) {
-                Move bestMoveOfAll = engineFuture.get();
-                if (bestMoveOfAll.pieceMoved == nullptr) {
+            if (isEngineThinking && resultReady) {
+                LOG("AI search depth " + std::to_string(result.search.depth) + ", nodes " + std::to_string(result.search.nodes) +
+                    (worker ? ", threads " + std::to_string(engineThreads) : ", cooperative"));
+                Move bestMoveOfAll = result.search.bestMove;
+
+                for (size_t i = 0; i < result.search.lines.size(); ++i) {
+                    const Move& m = result.search.lines[i].move;
+                    string name = string(1, (char)('a' + m.from.col)) + (char)('1' + m.from.row) + (char)('a' + m.to.col) + (char)('1' + m.to.row);
+                    LOG("AI line " + std::to_string(i + 1) + ": " + name + " " + std::to_string(result.search.lines[i].score));
+                }
+
+                // Easy mode: a weaker but still sensible line instead of the best one
+                if (difficultyLevel == 1 && !result.search.lines.empty()) {
+                    bestMoveOfAll = pickEasyMove(result.search);
+                    if (!sameMove(bestMoveOfAll, result.search.bestMove))
+                        LOG("AI on Easy Mode played a weaker line");
+                }
+
+                if (bestMoveOfAll.from.row < 0) {
                     if (engine.isInCheck(*board, 1)) statusText.setString("SZACH MAT!\nWygrywaja BIALE");
                     else statusText.setString("PAT!\nRemis");
                     gameOver = true;
@@ -618,17 +728,10 @@ int main() {
                 else {
                     Position from = bestMoveOfAll.from;
                     Position to = bestMoveOfAll.to;
-                    Piece* realPiece = board->getPieceAt(from);
-                    Piece* captured = board->getPieceAt(to);
-                    if (realPiece) {
-                        board->movePiece(from, to, realPiece);
-                        if (captured) delete captured;
-                        if (realPiece->getSymbol() == 'P' && (to.row == 0 || to.row == 7)) {
-                            board->promotePawn(*board, to, 'Q', currentPlayer);
-                        }
-                        board->computeZobristHash();
-                        board->positionHistory.push_back(board->zobristKey);
+                    if (board->getPieceAt(from)) {
+                        playMove(*board, from, to, currentPlayer);
                         currentPlayer = 0;
+                        ++moveNumber;
                     }
                     isEngineThinking = false;
 
@@ -639,11 +742,24 @@ int main() {
                         }
                         else statusText.setString("SZACH!");
                     }
+
+                    // Ponder on the human's expected reply, or on the whole position if none is known
+                    if (worker && !gameOver && currentPlayer == 0) {
+                        Board ponderBoard = *board;
+                        ponderMove = expectedReply(ponderBoard);
+                        if (ponderMove.pieceMoved)
+                            playMove(ponderBoard, ponderMove.from, ponderMove.to, 0);
+                        worker->ponder(PositionSnapshot::of(ponderBoard),
+                            limitsFor(difficultyLevel, (int)(timeBlack * 1000.0f), moveNumber));
+                        isPondering = true;
+                    }
                 }
             }
         }
     }
 
+    stopPondering();
+    worker.reset();
     delete board;
     return 0;
 }
\ No newline at end of file
@@ -20,10 +20,16 @@
 #include "../engine/tables/TT.h"
 #include "../engine/tables/zobrist.h"
 #include "../engine/engine.h"
+#include "../engine/see.h"
 #include "../engine/val.h"
+#include "../engine/search.h"
+#include "../engine/worker.h"
+#include "../engine/resumable.h"
+#include "../engine/params.h"
 #include "../engine/logger/logger.h"
 #include <thread>
 #include <chrono>
+#include <future>
 
 // --- Helpers ---
 /**
@@ -90,6 +96,82 @@ TEST_CASE("Transposition Table Coverage", "[TT]") {
         REQUIRE(!TT.probe(222, 5, -1000, 1000, score, outM));
         // Miss (depth)
         REQUIRE(!TT.probe(111, 6, -1000, 1000, score, outM));
+        // Packed move round trip
+        REQUIRE(outM.from.row == 0); REQUIRE(outM.from.col == 0);
+        REQUIRE(outM.to.row == 1); REQUIRE(outM.to.col == 1);
+        // Static eval and mate scores fit the 16-bit fields
+        int ev = 0;
+        TT.store(555, -MATE_SCORE + 3, 2, TT_EXACT, m, -123);
+        REQUIRE(TT.probe(555, 2, -INF, INF, score, outM, &ev));
+        REQUIRE(score == -MATE_SCORE + 3);
+        REQUIRE(ev == -123);
+    }
+    SECTION("Torn entry is a miss") {
+        Move m; m.from = { 6,4 }; m.to = { 7,4 }; m.promotion = 'Q';
+        TT.store(333, -250, 4, TT_BETA, m);
+        int score = 0; Move outM;
+        REQUIRE(TT.probe(333, 4, -1000, -300, score, outM));
+        REQUIRE(score == -300);
+        REQUIRE(outM.promotion == 'Q');
+        // Simulate a concurrent write that only replaced the data word
+        TT.clusterFor(333).data[0].store(TranspositionTable::packData(500, 9, TT_EXACT, m));
+        REQUIRE(!TT.probe(333, 4, -1000, 1000, score, outM));
+    }
+    SECTION("Resize keeps a power-of-two cluster count") {
+        TT.resize(3);
+        REQUIRE(TT.sizeMB() == 2);
+        REQUIRE((TT.size & TT.mask) == 0);
+        Move m; m.from = { 0,1 }; m.to = { 2,2 };
+        TT.store(777, 42, 3, TT_EXACT, m);
+        int score = 0; Move outM;
+        REQUIRE(TT.probe(777, 3, -1000, 1000, score, outM));
+        REQUIRE(score == 42);
+        TT.resize(64);
+        REQUIRE(!TT.probe(777, 3, -1000, 1000, score, outM));
+        // Parallel clear reaches every slice
+        TT.store(777, 42, 3, TT_EXACT, m);
+        TT.store(777 + (TT.mask & ~0xFFFULL), 42, 3, TT_EXACT, m);
+        SearchPool pool(4);
+        pool.clearTT();
+        REQUIRE(!TT.probe(777, 3, -1000, 1000, score, outM));
+        REQUIRE(!TT.probe(777 + (TT.mask & ~0xFFFULL), 3, -1000, 1000, score, outM));
+    }
+    SECTION("Cluster replacement prefers shallow and old entries") {
+        Move m; m.from = { 1,0 }; m.to = { 2,0 };
+        unsigned long long n = TT.size;
+        // Same cluster, different verification bits (top 16 key bits)
+        auto key = [n](int i) { return 444 + ((unsigned long long)(i + 1) * n << 28); };
+        int depths[TT_CLUSTER_SIZE] = { 10, 2, 8, 9, 12, 11 };
+        for (int i = 0; i < TT_CLUSTER_SIZE; ++i)
+            TT.store(key(i), 0, depths[i], TT_EXACT, m); // Same cluster
+        int score; Move outM;
+        // Cluster is full, the depth 2 entry is the one to go
+        TT.store(key(6), 0, 1, TT_EXACT, m);
+        REQUIRE(TT.probe(key(6), 1, -1000, 1000, score, outM));
+        REQUIRE(!TT.probe(key(1), 1, -1000, 1000, score, outM));
+        REQUIRE(TT.probe(key(0), 10, -1000, 1000, score, outM));
+        // Two searches later a refreshed depth 1 entry outlives the old depth 8 entry
+        TT.newSearch(); TT.newSearch();
+        TT.store(key(6), 0, 1, TT_EXACT, m);
+        TT.store(key(7), 0, 3, TT_EXACT, m);
+        REQUIRE(TT.probe(key(6), 1, -1000, 1000, score, outM));
+        REQUIRE(TT.probe(key(7), 3, -1000, 1000, score, outM));
+        REQUIRE(!TT.probe(key(2), 1, -1000, 1000, score, outM));
+    }
+    SECTION("Same position: deeper bound kept with the newer move, exact result replaces it") {
+        Move a; a.from = { 1,1 }; a.to = { 3,1 };
+        Move b; b.from = { 1,2 }; b.to = { 3,2 };
+        TT.store(555, 300, 6, TT_BETA, a);
+        TT.store(555, 50, 3, TT_BETA, b);
+        int score = 0; Move outM;
+        REQUIRE(TT.probe(555, 6, -1000, 200, score, outM));
+        REQUIRE(score == 200);
+        REQUIRE(sameMove(outM, b));
+        TT.store(555, 40, 2, TT_EXACT, a);
+        REQUIRE(!TT.probe(555, 6, -1000, 200, score, outM));
+        REQUIRE(TT.probe(555, 2, -1000, 1000, score, outM));
+        REQUIRE(score == 40);
+        REQUIRE(sameMove(outM, a));
     }
 }
 
@@ -213,12 +295,13 @@ TEST_CASE("Board Internals Coverage", "[Board]") {
  * @return Result of the operation.
  */
 TEST_CASE("Engine Logic Coverage", "[Engine]") {
+    Engine e;
     Board b;
     b.placePiece(new King(0, 'K', { 0,0 }));
     b.placePiece(new King(1, 'K', { 7,7 }));
 
     SECTION("Eval Function") {
-        REQUIRE(eval(b, 1) == 0);
+        REQUIRE(e.eval(b, 1) == 0);
         /**
  * @brief Test helper: c h e c k.
  *
@@ -227,9 +310,9 @@ TEST_CASE("Engine Logic Coverage", "[Engine]") {
  * @return Result of the operation.
  */
         b.placePiece(new Pawn(0, 'P', { 1,1 }));
-        REQUIRE(eval(b, 1) > 0);
+        REQUIRE(e.eval(b, 1) > 0);
 
-        int scoreEdge = eval(b, 1);
+        int scoreEdge = e.eval(b, 1);
         delete b.squares[1][1]; b.squares[1][1] = nullptr;
         // Place pawn in center manually
         b.placePiece(new Pawn(0, 'P', { 1,4 }));
@@ -240,7 +323,7 @@ TEST_CASE("Engine Logic Coverage", "[Engine]") {
  * @param scoreCenter Parameter.
  * @return Result of the operation.
  */
-        int scoreCenter = eval(b, 1);
+        int scoreCenter = e.eval(b, 1);
         // PST should make a difference
         CHECK(scoreCenter != scoreEdge);
     }
@@ -289,7 +372,7 @@ TEST_CASE("Engine Logic Coverage", "[Engine]") {
         b.placePiece(new Queen(1, 'Q', { 1,1 })); // Protects others
 
         // Verification: Does engine see check?
-        REQUIRE(isInCheck(b, 0) == true);
+        REQUIRE(e.isInCheck(b, 0) == true);
 
         /**
  * @brief Test helper: r e q u i r e.
@@ -300,8 +383,556 @@ TEST_CASE("Engine Logic Coverage", "[Engine]") {
  */
         // Run negamax for White (Sign=1 -> ID=0)
         // Expecting result indicating loss (very low negative value)
-        int score = negamax(b, 1, -100000, 100000, 1);
+        int score = e.negamax(b, 1, -100000, 100000, 1);
 
         REQUIRE(score < -10000);
     }
-}
\ No newline at end of file
+}
+// -----------------------------------------------------------------------------
+// 6. MOVE ORDERING TESTS
+// -----------------------------------------------------------------------------
+TEST_CASE("Killer and history tables", "[Ordering]") {
+    HistoryTables h;
+    Move a; a.from = { 0,1 }; a.to = { 2,2 }; a.pieceMoved = nullptr; a.pieceCaptured = nullptr;
+    Move b; b.from = { 1,4 }; b.to = { 3,4 }; b.pieceMoved = nullptr; b.pieceCaptured = nullptr;
+
+    SECTION("Killer slots shift") {
+        h.storeKiller(3, a);
+        h.storeKiller(3, b);
+        REQUIRE(h.killerSlot(3, b) == 0);
+        REQUIRE(h.killerSlot(3, a) == 1);
+        REQUIRE(h.killerSlot(4, a) == -1);
+        // Same killer twice does not evict the second slot
+        h.storeKiller(3, b);
+        REQUIRE(h.killerSlot(3, a) == 1);
+    }
+
+    SECTION("History gravity saturates and ages") {
+        for (int i = 0; i < 1000; ++i) h.update(0, a, 400);
+        REQUIRE(h.get(0, a) > 0);
+        REQUIRE(h.get(0, a) <= HISTORY_MAX);
+        REQUIRE(h.get(1, a) == 0);
+        int before = h.get(0, a);
+        h.age();
+        REQUIRE(h.get(0, a) == before / 2);
+        REQUIRE(h.killerSlot(3, a) == -1);
+    }
+
+    SECTION("Countermove and continuation history") {
+        REQUIRE(h.counterMove(-1, 0).from.row == -1);
+        h.storeCounterMove(7, 21, b);
+        REQUIRE(sameMove(h.counterMove(7, 21), b));
+        h.updateContinuation(7, 21, 0, 28, 64);
+        REQUIRE(h.getContinuation(7, 21, 0, 28) > 0);
+        REQUIRE(h.getContinuation(7, 21, 0, 27) == 0);
+        REQUIRE(h.getContinuation(-1, 21, 0, 28) == 0);
+    }
+}
+
+TEST_CASE("SEE of moves", "[SEE]") {
+    Board b;
+    b.placePiece(new King(0, 'K', { 0,0 }));
+    b.placePiece(new King(1, 'K', { 7,7 }));
+    b.placePiece(new Queen(0, 'Q', { 3,3 }));
+    b.placePiece(new Pawn(1, 'P', { 4,4 }));
+    b.placePiece(new Pawn(1, 'P', { 5,5 })); // Defends e5 pawn
+
+    Move qxp; qxp.from = { 3,3 }; qxp.to = { 4,4 };
+    qxp.pieceMoved = b.getPieceAt({ 3,3 }); qxp.pieceCaptured = b.getPieceAt({ 4,4 });
+    // QxP defended by a pawn loses the queen for a pawn
+    REQUIRE(seeMove(b, qxp) < 0);
+    // Board is restored
+    REQUIRE(b.getPieceAt({ 3,3 }) == qxp.pieceMoved);
+    REQUIRE(b.getPieceAt({ 4,4 }) == qxp.pieceCaptured);
+
+    Move quiet; quiet.from = { 3,3 }; quiet.to = { 3,6 };
+    quiet.pieceMoved = b.getPieceAt({ 3,3 }); quiet.pieceCaptured = nullptr;
+    REQUIRE(seeMove(b, quiet) == 0);
+
+    SECTION("X-ray recapture behind the first attacker") {
+        Board x;
+        x.placePiece(new King(0, 'K', { 0,7 }));
+        x.placePiece(new King(1, 'K', { 7,7 }));
+        x.placePiece(new Rook(0, 'R', { 0,0 }));
+        x.placePiece(new Rook(0, 'R', { 1,0 }));
+        x.placePiece(new Pawn(1, 'P', { 5,0 }));
+        x.placePiece(new Rook(1, 'R', { 7,0 }));
+        Move rxp; rxp.from = { 1,0 }; rxp.to = { 5,0 };
+        rxp.pieceMoved = x.getPieceAt({ 1,0 }); rxp.pieceCaptured = x.getPieceAt({ 5,0 });
+        // RxP, RxR, RxR: the rook on a1 supports through the rook on a2
+        REQUIRE(seeMove(x, rxp) == 100);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// 7. SEARCH TESTS
+// -----------------------------------------------------------------------------
+TEST_CASE("Mate scores", "[Search]") {
+    initZobrist();
+    TT.clear();
+
+    SECTION("TT stores mate scores relative to the node") {
+        Move m; m.from = { 0,0 }; m.to = { 7,0 };
+        // Mate 5 plies from the root, stored at ply 3 (2 plies from the node)
+        TT.store(888, MATE_SCORE - 5, 4, TT_EXACT, m, TT_EVAL_NONE, 3);
+        int score = 0; Move outM;
+        REQUIRE(TT.probe(888, 4, -INF, INF, score, outM, nullptr, 1));
+        REQUIRE(score == MATE_SCORE - 3);
+    }
+
+    SECTION("Back rank mate in one") {
+        Board b;
+        b.placePiece(new King(0, 'K', { 0,4 }));
+        b.placePiece(new Rook(0, 'R', { 0,0 }));
+        b.placePiece(new King(1, 'K', { 7,7 }));
+        b.placePiece(new Pawn(1, 'P', { 6,6 }));
+        b.placePiece(new Pawn(1, 'P', { 6,7 }));
+        b.computeZobristHash();
+        Engine e;
+        // Found at every depth, always at distance 1 from the root
+        REQUIRE(e.negamax(b, 2, -INF, INF, 1) == MATE_SCORE - 1);
+        REQUIRE(e.negamax(b, 3, -INF, INF, 1) == MATE_SCORE - 1);
+        // Best move is recorded in the TT and ordered first on the next visit
+        int score = 0; Move ttMove;
+        TT.probe(b.zobristKey, 0, -INF, INF, score, ttMove);
+        REQUIRE(ttMove.from.row == 0); REQUIRE(ttMove.from.col == 0);
+        REQUIRE(ttMove.to.row == 7); REQUIRE(ttMove.to.col == 0);
+        auto moves = e.legalMoves(b, 0);
+        e.orderMoves(b, moves, 0, 0, ttMove);
+        REQUIRE(sameMove(moves[0], ttMove));
+    }
+}
+
+TEST_CASE("Repetition stack", "[Search]") {
+    initZobrist();
+
+    SECTION("Knight shuffle repeats after 4 plies") {
+        Board b;
+        b.placePiece(new King(0, 'K', { 0,4 }));
+        b.placePiece(new Knight(0, 'N', { 0,6 }));
+        b.placePiece(new King(1, 'K', { 7,4 }));
+        b.placePiece(new Knight(1, 'N', { 7,6 }));
+        b.computeZobristHash();
+        Engine e;
+        e.repetitions.reset(b.positionHistory, b.zobristKey, b.halfmoveClock);
+
+        Move path[4] = {
+            { {0,6}, {2,5}, b.getPieceAt({0,6}), nullptr },
+            { {7,6}, {5,5}, b.getPieceAt({7,6}), nullptr },
+            { {2,5}, {0,6}, b.getPieceAt({0,6}), nullptr },
+            { {5,5}, {7,6}, b.getPieceAt({7,6}), nullptr },
+        };
+        Engine::Undo undo[4];
+        for (int i = 0; i < 4; ++i) {
+            REQUIRE_FALSE(e.isRepetition());
+            e.applyMove(b, path[i], undo[i]);
+            e.repetitions.push(b.zobristKey, b.halfmoveClock);
+        }
+        REQUIRE(e.isRepetition());
+        // Incremental key keeps the side to move in step with a full recompute
+        unsigned long long incremental = b.zobristKey;
+        b.computeZobristHash();
+        REQUIRE(b.zobristKey == incremental);
+    }
+
+    SECTION("Cuckoo table finds a repetition one move away") {
+        REQUIRE(initCuckoo() == CUCKOO_MOVES);
+        // Rooks shuffle Ra1-a3, Rh8-h6, Ra3-a1, black to move can answer Rh6-h8
+        auto upcoming = [](bool blockH7, int ply) {
+            Board b;
+            b.placePiece(new King(0, 'K', { 0,4 }));
+            b.placePiece(new Rook(0, 'R', { 0,0 }));
+            b.placePiece(new King(1, 'K', { 7,4 }));
+            b.placePiece(new Rook(1, 'R', { 7,7 }));
+            if (blockH7) b.placePiece(new Pawn(0, 'P', { 6,7 }));
+            b.computeZobristHash();
+            Engine e;
+            e.repetitions.reset(b.positionHistory, b.zobristKey, b.halfmoveClock);
+            Position path[3][2] = { { {0,0}, {2,0} }, { {7,7}, {5,7} }, { {2,0}, {0,0} } };
+            for (auto& step : path) {
+                Engine::Undo undo;
+                e.applyMove(b, { step[0], step[1], b.getPieceAt(step[0]), nullptr }, undo);
+                e.repetitions.push(b.zobristKey, b.halfmoveClock);
+            }
+            return e.upcomingRepetition(b, ply);
+        };
+        REQUIRE(upcoming(false, 4));
+        // The earlier position is the root: it has to be repeated in the game already
+        REQUIRE_FALSE(upcoming(false, 3));
+        // Rh6-h8 is blocked
+        REQUIRE_FALSE(upcoming(true, 4));
+    }
+
+    SECTION("Lookup stops at an irreversible move") {
+        RepetitionStack s;
+        s.reset({}, 1, 0);
+        s.push(2, 1);
+        s.push(3, 0);
+        s.push(4, 1);
+        s.push(1, 2); // Same key as the root, but behind the irreversible move
+        REQUIRE_FALSE(s.repeated());
+        s.push(6, 3);
+        s.push(3, 4);
+        REQUIRE(s.repeated());
+    }
+}
+
+TEST_CASE("Draw rules", "[Search]") {
+    initZobrist();
+
+    SECTION("Halfmove clock and material signature follow apply/undo") {
+        Board b;
+        b.placePiece(new King(0, 'K', { 0,4 }));
+        b.placePiece(new Pawn(0, 'P', { 6,0 }));
+        b.placePiece(new King(1, 'K', { 7,4 }));
+        b.placePiece(new Knight(1, 'N', { 7,1 }));
+        b.halfmoveClock = 7;
+        b.computeZobristHash();
+        unsigned long long material = b.materialKey;
+        REQUIRE(b.materialCount(getPieceIndex('P', 0)) == 1);
+        REQUIRE(b.materialCount(getPieceIndex('N', 1)) == 1);
+        REQUIRE_FALSE(b.insufficientMaterial());
+
+        Engine e;
+        Engine::Undo undo;
+        // a7xb8=Q: capture and promotion at once
+        Move m{ {6,0}, {7,1}, b.getPieceAt({6,0}), b.getPieceAt({7,1}), 'Q' };
+        e.applyMove(b, m, undo);
+        REQUIRE(b.halfmoveClock == 0);
+        REQUIRE(b.materialCount(getPieceIndex('P', 0)) == 0);
+        REQUIRE(b.materialCount(getPieceIndex('Q', 0)) == 1);
+        REQUIRE(b.materialCount(getPieceIndex('N', 1)) == 0);
+        unsigned long long incremental = b.materialKey;
+        b.computeZobristHash();
+        REQUIRE(b.materialKey == incremental);
+
+        e.undoMove(b, m, undo);
+        REQUIRE(b.halfmoveClock == 7);
+        REQUIRE(b.materialKey == material);
+    }
+
+    SECTION("King and minor piece against king is a dead draw") {
+        Board b;
+        b.placePiece(new King(0, 'K', { 0,4 }));
+        b.placePiece(new Bishop(0, 'B', { 0,2 }));
+        b.placePiece(new King(1, 'K', { 7,4 }));
+        b.computeZobristHash();
+        REQUIRE(b.insufficientMaterial());
+        Engine e;
+        REQUIRE(e.negamax(b, 3, -INF, INF, -1, 1) == 0);
+
+        b.placePiece(new Knight(0, 'N', { 0,6 }));
+        b.computeZobristHash();
+        REQUIRE_FALSE(b.insufficientMaterial());
+    }
+
+    SECTION("Fifty-move rule") {
+        Board b;
+        b.placePiece(new King(0, 'K', { 0,4 }));
+        b.placePiece(new Queen(0, 'Q', { 0,3 }));
+        b.placePiece(new King(1, 'K', { 7,4 }));
+        b.halfmoveClock = 100;
+        b.computeZobristHash();
+        Engine e;
+        REQUIRE(e.negamax(b, 3, -INF, INF, -1, 1) == 0);
+    }
+
+    SECTION("Checkmate on the hundredth half-move is not a draw") {
+        TT.clear();
+        Board b;
+        b.placePiece(new King(0, 'K', { 0,4 }));
+        b.placePiece(new Rook(0, 'R', { 7,0 }));
+        b.placePiece(new King(1, 'K', { 7,7 }));
+        b.placePiece(new Pawn(1, 'P', { 6,6 }));
+        b.placePiece(new Pawn(1, 'P', { 6,7 }));
+        b.halfmoveClock = 100;
+        b.computeZobristHash();
+        Engine e;
+        REQUIRE(e.negamax(b, 3, -INF, INF, -1, 1) == -MATE_SCORE + 1);
+    }
+}
+
+TEST_CASE("Time limits", "[Search]") {
+    initZobrist();
+    TT.clear();
+
+    Board b;
+    b.placePiece(new King(0, 'K', { 0,4 }));
+    b.placePiece(new Queen(0, 'Q', { 0,3 }));
+    b.placePiece(new Rook(0, 'R', { 0,0 }));
+    b.placePiece(new Knight(0, 'N', { 0,6 }));
+    b.placePiece(new Pawn(0, 'P', { 1,4 }));
+    b.placePiece(new King(1, 'K', { 7,4 }));
+    b.placePiece(new Queen(1, 'Q', { 7,3 }));
+    b.placePiece(new Rook(1, 'R', { 7,7 }));
+    b.placePiece(new Knight(1, 'N', { 7,1 }));
+    b.placePiece(new Pawn(1, 'P', { 6,4 }));
+    b.computeZobristHash();
+
+    SearchPool pool(1);
+    SearchLimits limits;
+    limits.maxDepth = 64;
+    limits.timeLimitMs = 30;
+    limits.hardLimitMs = 60;
+
+    auto start = std::chrono::steady_clock::now();
+    SearchResult r = pool.search(b, 0, limits);
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    // Aborted inside the tree, the move comes from the last completed iteration
+    REQUIRE(r.bestMove.pieceMoved != nullptr);
+    REQUIRE(r.depth >= 1);
+    REQUIRE(r.depth < 64);
+    REQUIRE(elapsed < 60 + 100);
+}
+
+TEST_CASE("Time allocation from the game clock", "[Search]") {
+    TimeManager tm;
+    tm.startFromClock(60000, 0, 1);
+    int optimum = tm.softLimitMs;
+    REQUIRE(optimum > 0);
+    REQUIRE(tm.hardLimitMs > optimum);
+    REQUIRE(tm.hardLimitMs <= 60000 * TM_MAX_CLOCK_PERCENT / 100);
+
+    // Less of the clock per move early in the game than later on
+    TimeManager late;
+    late.startFromClock(60000, 0, 60);
+    REQUIRE(late.softLimitMs > optimum);
+
+    // Stable best move: the soft limit shrinks to half the optimum
+    for (int i = 0; i < 8; ++i) tm.onIteration(false, 0);
+    REQUIRE(tm.softLimitMs == optimum / 2);
+    // New best move after a score drop: extended, capped by the hard limit
+    tm.onIteration(true, TM_SCORE_DROP);
+    REQUIRE(tm.softLimitMs > optimum);
+    REQUIRE(tm.softLimitMs <= tm.hardLimitMs);
+}
+
+TEST_CASE("Pondering", "[Search]") {
+    initZobrist();
+    TT.clear();
+
+    Board b;
+    b.placePiece(new King(0, 'K', { 0,4 }));
+    b.placePiece(new Queen(0, 'Q', { 0,3 }));
+    b.placePiece(new Rook(0, 'R', { 0,0 }));
+    b.placePiece(new Pawn(0, 'P', { 1,4 }));
+    b.placePiece(new King(1, 'K', { 7,4 }));
+    b.placePiece(new Queen(1, 'Q', { 7,3 }));
+    b.placePiece(new Rook(1, 'R', { 7,7 }));
+    b.placePiece(new Pawn(1, 'P', { 6,4 }));
+    b.sideToMove = 1;
+    b.computeZobristHash();
+
+    SearchPool pool(2);
+    SearchLimits limits;
+    limits.timeLimitMs = 20;
+    limits.hardLimitMs = 40;
+    limits.ponder = true;
+
+    auto future = std::async(std::launch::async, [&]() { return pool.search(b, 1, limits); });
+    // Limits are suspended while pondering
+    REQUIRE(future.wait_for(std::chrono::milliseconds(150)) == std::future_status::timeout);
+    REQUIRE(pool.isRunning());
+
+    // Ponder hit: the limits count from now on
+    pool.ponderhit();
+    REQUIRE(future.wait_for(std::chrono::milliseconds(40 + 200)) == std::future_status::ready);
+    SearchResult r = future.get();
+    REQUIRE(r.bestMove.pieceMoved != nullptr);
+    REQUIRE_FALSE(pool.isRunning());
+}
+
+TEST_CASE("Engine worker", "[Search]") {
+    initZobrist();
+    TT.clear();
+
+    Board b;
+    b.placePiece(new King(0, 'K', { 0,4 }));
+    b.placePiece(new Rook(0, 'R', { 0,0 }));
+    b.placePiece(new King(1, 'K', { 7,4 }));
+    b.placePiece(new Pawn(1, 'P', { 6,4 }));
+    b.sideToMove = 1;
+    b.computeZobristHash();
+    b.positionHistory.push_back(b.zobristKey);
+
+    // Snapshot round trip keeps the position
+    PositionSnapshot snap = PositionSnapshot::of(b);
+    Board copy;
+    snap.apply(copy);
+    REQUIRE(copy.zobristKey == b.zobristKey);
+    REQUIRE(copy.materialKey == b.materialKey);
+    REQUIRE(copy.positionHistory == b.positionHistory);
+    REQUIRE(copy.getPieceAt({ 6,4 })->symbol == 'P');
+
+    EngineWorker worker(2);
+    SearchLimits limits;
+    limits.timeLimitMs = 20;
+    limits.hardLimitMs = 40;
+
+    unsigned id = worker.search(snap, limits);
+    EngineResult r = worker.waitResult();
+    REQUIRE(r.id == id);
+    REQUIRE(r.search.bestMove.from.row >= 0);
+    REQUIRE(r.search.bestMove.pieceMoved == nullptr); // Squares only
+
+    // Ponder results are kept back until the ponder hit
+    unsigned ponderId = worker.ponder(snap, limits);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    REQUIRE_FALSE(worker.tryTakeResult(r));
+    REQUIRE(worker.ponderhit());
+    r = worker.waitResult();
+    REQUIRE(r.id == ponderId);
+
+    // Stopped ponder searches deliver nothing
+    worker.ponder(snap, limits);
+    worker.stop();
+    REQUIRE_FALSE(worker.ponderhit());
+    worker.newGame();
+    worker.search(snap, limits);
+    REQUIRE(worker.waitResult().search.bestMove.from.row >= 0);
+    REQUIRE_FALSE(worker.tryTakeResult(r));
+}
+
+TEST_CASE("Search progress", "[Search]") {
+    initZobrist();
+    TT.clear();
+
+    Board b;
+    b.placePiece(new King(0, 'K', { 0,4 }));
+    b.placePiece(new Queen(0, 'Q', { 0,3 }));
+    b.placePiece(new Pawn(0, 'P', { 1,4 }));
+    b.placePiece(new King(1, 'K', { 7,4 }));
+    b.placePiece(new Rook(1, 'R', { 7,7 }));
+    b.placePiece(new Pawn(1, 'P', { 6,4 }));
+    b.computeZobristHash();
+
+    SearchPool pool(2);
+    SearchLimits limits;
+    limits.maxDepth = 5; // A depth limit, a time limit can end it before depth 1 on a loaded machine
+
+    // Read concurrently while the search publishes
+    auto future = std::async(std::launch::async, [&]() { return pool.search(b, 0, limits); });
+    int lastDepth = 0;
+    while (future.wait_for(std::chrono::milliseconds(1)) != std::future_status::ready) {
+        SearchInfo live = pool.progress().read();
+        REQUIRE(live.pvLength <= PROGRESS_MAX_PV);
+        REQUIRE(live.depth >= lastDepth);
+        lastDepth = live.depth;
+    }
+    SearchResult r = future.get();
+
+    SearchInfo info = pool.progress().read();
+    REQUIRE(info.depth == r.depth);
+    REQUIRE(info.color == 0);
+    REQUIRE(info.nodes == r.nodes);
+    REQUIRE(info.nps > 0);
+    REQUIRE(info.hashfull >= 0);
+    REQUIRE(info.hashfull <= 1000);
+    REQUIRE(info.pvLength >= 1);
+    int from = r.bestMove.from.row * 8 + r.bestMove.from.col;
+    int to = r.bestMove.to.row * 8 + r.bestMove.to.col;
+    if (r.threadId == 0) REQUIRE(info.pv[0] == (from | (to << 6)));
+}
+
+TEST_CASE("Resumable search", "[Search]") {
+    initZobrist();
+
+    Board b;
+    b.placePiece(new King(0, 'K', { 0,4 }));
+    b.placePiece(new Queen(0, 'Q', { 0,3 }));
+    b.placePiece(new Pawn(0, 'P', { 1,4 }));
+    b.placePiece(new King(1, 'K', { 7,4 }));
+    b.placePiece(new Rook(1, 'R', { 7,7 }));
+    b.placePiece(new Pawn(1, 'P', { 6,4 }));
+    b.computeZobristHash();
+
+    SearchLimits limits;
+    limits.maxDepth = 5;
+    limits.timeLimitMs = 1000000;
+
+    TT.clear();
+    SearchPool pool(1);
+    SearchResult plain = pool.search(b, 0, limits);
+
+    // Same tree in small slices
+    TT.clear();
+    ResumableSearch search(256);
+    search.start(b, 0, limits);
+    REQUIRE_FALSE(search.finished());
+    while (!search.step()) {}
+    SearchResult r = search.result();
+    REQUIRE(search.slices() > 1);
+    REQUIRE(r.depth == plain.depth);
+    REQUIRE(r.score == plain.score);
+    REQUIRE(r.nodes == plain.nodes);
+    REQUIRE(r.bestMove.from.row == plain.bestMove.from.row);
+    REQUIRE(r.bestMove.to.col == plain.bestMove.to.col);
+    REQUIRE(search.progress().read().depth == 5);
+
+    // Stopped between slices: deepest completed iteration
+    limits.maxDepth = 64;
+    search.start(b, 0, limits);
+    for (int i = 0; i < 50 && !search.step(); ++i) {}
+    search.stop();
+    REQUIRE(search.step());
+    REQUIRE(search.result().bestMove.from.row >= 0);
+}
+
+TEST_CASE("MultiPV", "[Search]") {
+    initZobrist();
+
+    // White wins the rook with Qxh8
+    Board b;
+    b.placePiece(new King(0, 'K', { 0,4 }));
+    b.placePiece(new Queen(0, 'Q', { 3,7 }));
+    b.placePiece(new Pawn(0, 'P', { 1,0 }));
+    b.placePiece(new King(1, 'K', { 7,0 }));
+    b.placePiece(new Rook(1, 'R', { 7,7 }));
+    b.placePiece(new Pawn(1, 'P', { 6,0 }));
+    b.computeZobristHash();
+
+    SearchLimits limits;
+    limits.maxDepth = 4;
+    limits.timeLimitMs = 1000000;
+    limits.multiPV = 3;
+
+    TT.clear();
+    SearchPool pool(1);
+    SearchResult r = pool.search(b, 0, limits);
+    REQUIRE(r.lines.size() == 3);
+    REQUIRE(sameMove(r.lines[0].move, r.bestMove));
+    REQUIRE(r.lines[0].score == r.score);
+    REQUIRE(r.bestMove.to.row == 7);
+    REQUIRE(r.bestMove.to.col == 7);
+    for (size_t i = 1; i < r.lines.size(); ++i) {
+        REQUIRE(r.lines[i].score <= r.lines[i - 1].score);
+        for (size_t j = 0; j < i; ++j)
+            REQUIRE_FALSE(sameMove(r.lines[i].move, r.lines[j].move));
+    }
+
+    // The resumable search ranks the same lines
+    TT.clear();
+    ResumableSearch resumable(1024);
+    resumable.start(b, 0, limits);
+    while (!resumable.step()) {}
+    SearchResult rr = resumable.result();
+    REQUIRE(rr.lines.size() == 3);
+    REQUIRE(rr.nodes == r.nodes);
+    for (size_t i = 0; i < 3; ++i)
+        REQUIRE(rr.lines[i].score == r.lines[i].score);
+
+    // One line by default, more lines than moves are capped
+    limits.multiPV = 1;
+    REQUIRE(pool.search(b, 0, limits).lines.size() == 1);
+    Board lone;
+    lone.placePiece(new King(0, 'K', { 0,0 }));
+    lone.placePiece(new Pawn(0, 'P', { 1,0 }));
+    lone.placePiece(new King(1, 'K', { 2,1 }));
+    lone.computeZobristHash();
+    Engine e;
+    size_t legal = e.legalMoves(lone, 0).size();
+    REQUIRE(legal < 10);
+    limits.multiPV = 10;
+    REQUIRE(pool.search(lone, 0, limits).lines.size() == legal);
+}